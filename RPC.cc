@@ -1,4 +1,5 @@
 #include <iostream>
+#include <string>
 #include "G4RunManagerFactory.hh" 
 #include "G4UImanager.hh"
 #include "G4VisManager.hh"
@@ -8,13 +9,26 @@
 #include "DetectorConstruction.hh" 
 #include "PhysicsList.hh"
 #include "ActionInitialization.hh" 
+#include "LogMessenger.hh"
+#include "OutputMessenger.hh"
+#include "GunMessenger.hh"
+#include "ProfilerMessenger.hh"
+#include "ScanMessenger.hh"
+#include "RandomMessenger.hh"
+#include "JobOptions.hh"
 
 int main(int argc, char** argv)
 {
+    // Opções de job (--job, --jobs, --seed, --seed-offset, --output) e a macro
+    std::string macro;
+    if (!JobOptions::Parse(argc, argv, macro)) {
+        return 1;
+    }
+
     // Detecta o modo de sessão (gráfico ou batch)
     G4UIExecutive* ui = nullptr;
-    if (argc == 1) { // Modo interativo
-        ui = new G4UIExecutive(argc, argv);
+    if (macro.empty()) { // Modo interativo
+        ui = new G4UIExecutive(1, argv);
     }
 
     // -> MUDANÇA: Cria o RunManager apropriado (MT ou sequencial) automaticamente
@@ -29,6 +43,17 @@ int main(int argc, char** argv)
     // 3. Registra a ActionInitialization (que cuida das outras ações)
     runManager->SetUserInitialization(new ActionInitialization());
     
+    // Comandos /rpc/log/..., /rpc/output/..., /rpc/gun/... e /rpc/profile/...
+    LogMessenger* logMessenger = new LogMessenger();
+    OutputMessenger* outputMessenger = new OutputMessenger();
+    GunMessenger* gunMessenger = new GunMessenger();
+    ProfilerMessenger* profilerMessenger = new ProfilerMessenger();
+    ScanMessenger* scanMessenger = new ScanMessenger();
+    RandomMessenger* randomMessenger = new RandomMessenger();
+
+    // Sementes do job, antes da macro
+    JobOptions::Apply();
+
     // Inicializa o gerenciador de visualização
     G4VisManager* visManager = new G4VisExecutive();
     visManager->Initialize();
@@ -42,13 +67,18 @@ int main(int argc, char** argv)
         delete ui;
     } else { // Modo Batch
         G4String command = "/control/execute ";
-        G4String fileName = argv[1];
-        UImanager->ApplyCommand(command + fileName);
+        UImanager->ApplyCommand(command + macro);
     }
     
     // Limpeza da memória
     delete visManager;
     delete runManager;
+    delete randomMessenger;
+    delete scanMessenger;
+    delete profilerMessenger;
+    delete gunMessenger;
+    delete outputMessenger;
+    delete logMessenger;
 
     return 0;
 }
\ No newline at end of file
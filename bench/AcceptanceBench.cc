@@ -0,0 +1,178 @@
+// Microbenchmark do corte geométrico dos elétrons de ionização:
+//   - referência: laço sobre os clusters (array de structs), um teste com
+//     desvios por elétron e um preenchimento de H3 por elétron;
+//   - batch: ElectronBatch (estrutura de arrays, máscara sem desvios) e
+//     H3FillBuffer repassado uma vez por evento.
+// Os dois H3 têm de sair iguais em todos os acumuladores, não só nas contagens.
+// Não depende do Geant4/Garfield: os clusters são gerados aleatoriamente com
+// a mesma geometria do gap.
+//
+// Uso: rpc_bench_acceptance [eventos] [clusters por evento]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "H3FillBuffer.hh"
+#include "ElectronBatch.hh"
+
+namespace {
+
+struct Electron {
+  double x, y, z, t;
+};
+
+struct Cluster {
+  double x, y, z, t, energy;
+  std::vector<Electron> electrons;
+};
+
+// Substitui o G4AnalysisManager::FillH3: chamada fora de linha, um bin por
+// vez, com a unidade e a função de cada eixo (G4Fcn) aplicadas antes do
+// preenchimento e os mesmos acumuladores por bin do tools::histo::h3d
+// (entradas, Sw, Sw2 e Sxw/Sx2w por eixo).
+using Fcn = double (*)(double);
+double Identity(double v) { return v; }
+
+struct ReferenceH3 {
+  Fcn fcn[3] = {Identity, Identity, Identity};
+  double unit[3] = {1., 1., 1.};
+  int n[3];
+  double min[3], max[3];
+  std::vector<double> counts;
+  std::vector<double> sw2;
+  std::vector<std::vector<double>> sxw, sx2w;
+};
+
+ReferenceH3 MakeReferenceH3(const int n[3], const double min[3], const double max[3]) {
+  ReferenceH3 h;
+  for (int k = 0; k < 3; ++k) {
+    h.n[k] = n[k];
+    h.min[k] = min[k];
+    h.max[k] = max[k];
+  }
+  const std::size_t nBins = std::size_t(n[0] + 2) * (n[1] + 2) * (n[2] + 2);
+  h.counts.assign(nBins, 0.);
+  h.sw2.assign(nBins, 0.);
+  h.sxw.assign(nBins, std::vector<double>(3, 0.));
+  h.sx2w.assign(nBins, std::vector<double>(3, 0.));
+  return h;
+}
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void FillReference(ReferenceH3& h, double x, double y, double z, double w) {
+  const double v[3] = {h.fcn[0](x / h.unit[0]), h.fcn[1](y / h.unit[1]), h.fcn[2](z / h.unit[2])};
+  std::size_t idx[3];
+  for (int k = 0; k < 3; ++k) {
+    if (v[k] < h.min[k]) idx[k] = 0;
+    else if (v[k] >= h.max[k]) idx[k] = h.n[k] + 1;
+    else idx[k] = 1 + static_cast<std::size_t>((v[k] - h.min[k]) / (h.max[k] - h.min[k]) * h.n[k]);
+  }
+  const std::size_t bin = idx[0] + (h.n[0] + 2) * (idx[1] + (h.n[1] + 2) * idx[2]);
+  h.counts[bin] += w;
+  h.sw2[bin] += w * w;
+  for (int k = 0; k < 3; ++k) {
+    h.sxw[bin][k] += v[k] * w;
+    h.sx2w[bin][k] += v[k] * v[k] * w;
+  }
+}
+
+// Uma trilha reta por evento atravessando o gap (|y| <= 0.1 cm), com clusters
+// espalhados ao longo dela e parte deles fora da caixa de aceitação.
+std::vector<std::vector<Cluster>> MakeEvents(int nEvents, int nClusters) {
+  std::mt19937_64 rng(12345);
+  std::uniform_real_distribution<double> ux(-70., 70.);
+  std::uniform_real_distribution<double> uz(-90., 90.);
+  std::uniform_real_distribution<double> slope(-1., 1.);
+  std::uniform_real_distribution<double> uy(-0.12, 0.12);
+  std::uniform_real_distribution<double> spread(-0.005, 0.005);
+  std::geometric_distribution<int> size(0.35);
+  std::vector<std::vector<Cluster>> events(nEvents);
+  for (auto& clusters : events) {
+    const double x0 = ux(rng), z0 = uz(rng);
+    const double sx = slope(rng), sz = slope(rng);
+    clusters.resize(nClusters);
+    for (auto& c : clusters) {
+      c.y = uy(rng);
+      c.x = x0 + sx * c.y;
+      c.z = z0 + sz * c.y;
+      c.t = 0.;
+      c.energy = 30.;
+      const int ne = 1 + size(rng);
+      for (int i = 0; i < ne; ++i) {
+        c.electrons.push_back({c.x + spread(rng), c.y + spread(rng), c.z + spread(rng), 0.});
+      }
+    }
+  }
+  return events;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int nEvents = argc > 1 ? std::atoi(argv[1]) : 100000;
+  const int nClusters = argc > 2 ? std::atoi(argv[2]) : 20;
+  // Um conjunto pequeno de eventos é reaproveitado para que os clusters
+  // estejam em cache, como logo após o TrackHeed::NewTrack.
+  const auto pool = MakeEvents(256, nClusters);
+
+  const AcceptanceBox box{-0.1, 0.1, 64.25, 82.5};
+  // Mesma binagem do H3 "Track position" do RunAction [mm]
+  const int nBins[3] = {200, 29, 29};
+  const double lo[3] = {-100., -14.5, -14.5}, hi[3] = {100., 14.5, 14.5};
+
+  // Referência
+  ReferenceH3 ref = MakeReferenceH3(nBins, lo, hi);
+  long refAccepted = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int ev = 0; ev < nEvents; ++ev) {
+    const auto& clusters = pool[ev % pool.size()];
+    for (const auto& cluster : clusters) {
+      if (cluster.y < box.yMin || cluster.y > box.yMax || std::abs(cluster.x) > box.halfX ||
+          std::abs(cluster.z) > box.halfZ) continue;
+      for (const auto& e : cluster.electrons) {
+        if (e.y < box.yMin || e.y > box.yMax || std::abs(e.x) > box.halfX || std::abs(e.z) > box.halfZ) continue;
+        FillReference(ref, e.y * 10, e.x * 10, e.z * 10, 1.);
+        ++refAccepted;
+      }
+    }
+  }
+  const double tRef = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // Batch
+  ReferenceH3 out = MakeReferenceH3(nBins, lo, hi);
+  H3FillBuffer buffer;
+  buffer.Book();
+  ElectronBatch clusterBatch, electronBatch;
+  long batchAccepted = 0;
+  start = std::chrono::steady_clock::now();
+  for (int ev = 0; ev < nEvents; ++ev) {
+    const auto& clusters = pool[ev % pool.size()];
+    clusterBatch.Clear();
+    for (const auto& c : clusters) clusterBatch.Add(c.x, c.y, c.z, c.t);
+    clusterBatch.Accept(box);
+    electronBatch.Clear();
+    for (std::size_t i = 0; i < clusters.size(); ++i) {
+      if (!clusterBatch.IsAccepted(i)) continue;
+      for (const auto& e : clusters[i].electrons) electronBatch.Add(e.x, e.y, e.z, e.t);
+    }
+    batchAccepted += electronBatch.Accept(box);
+    buffer.FillBatch(electronBatch.YData(), electronBatch.XData(), electronBatch.ZData(),
+                    electronBatch.AcceptedData(), electronBatch.Size(), 10.);
+    buffer.Flush([&out](double x, double y, double z, double w) { FillReference(out, x, y, z, w); });
+  }
+  const double tBatch = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const bool same = refAccepted == batchAccepted && ref.counts == out.counts && ref.sw2 == out.sw2 &&
+                    ref.sxw == out.sxw && ref.sx2w == out.sx2w;
+  std::printf("eventos %d, clusters/evento %d, elétrons aceitos %ld\n", nEvents, nClusters, refAccepted);
+  std::printf("referência: %8.3f ms  (%.2f ns/elétron)\n", 1e3 * tRef, 1e9 * tRef / refAccepted);
+  std::printf("batch:      %8.3f ms  (%.2f ns/elétron)\n", 1e3 * tBatch, 1e9 * tBatch / batchAccepted);
+  std::printf("speedup %.2fx, histogramas %s\n", tRef / tBatch, same ? "idênticos" : "DIFERENTES");
+  return same ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+// Microbenchmark da consulta de campo feita pelo AvalancheMC a cada passo
+// (Sensor::ElectricField), com os três componentes do gap:
+//   - analytic: ComponentAnalyticField com os dois planos (referência);
+//   - uniform: ComponentUniformGap;
+//   - map: ComponentGapFieldMap amostrado do analytic.
+// Os pontos seguem linhas de drift curtas (passos de 1 um ao longo de y),
+// como no transporte. Não depende do Geant4; o meio não é inicializado
+// porque só o ponteiro é consultado.
+//
+// Uso: rpc_bench_field [passos] [passo do mapa em cm]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "ComponentGapFieldMap.hh"
+#include "ComponentUniformGap.hh"
+#include "Garfield/ComponentAnalyticField.hh"
+#include "Garfield/MediumMagboltz.hh"
+#include "Garfield/Sensor.hh"
+
+namespace {
+
+// Mesmo gap e tensão padrão do DetectorParameters, área reduzida
+constexpr double kGap = 0.2;
+constexpr double kHV = 6000.;
+constexpr double kHalfX = 10.;
+constexpr double kHalfZ = 10.;
+
+struct Point {
+  double x, y, z;
+};
+
+std::vector<Point> MakePath(std::size_t n) {
+  std::mt19937_64 rng(12345);
+  std::uniform_real_distribution<double> ux(-kHalfX, kHalfX);
+  std::uniform_real_distribution<double> uz(-kHalfZ, kHalfZ);
+  std::uniform_real_distribution<double> uy(-0.5 * kGap, 0.5 * kGap);
+  std::normal_distribution<double> diffusion(0., 2.e-5);
+  std::vector<Point> path;
+  path.reserve(n);
+  Point p{ux(rng), uy(rng), uz(rng)};
+  for (std::size_t i = 0; i < n; ++i) {
+    p.x += diffusion(rng);
+    p.z += diffusion(rng);
+    p.y -= 1.e-4;
+    if (p.y < -0.5 * kGap) p = Point{ux(rng), uy(rng), uz(rng)};
+    path.push_back(p);
+  }
+  return path;
+}
+
+void SetArea(Garfield::Sensor& sensor) {
+  sensor.SetArea(-kHalfX, -0.5 * kGap, -kHalfZ, kHalfX, 0.5 * kGap, kHalfZ);
+}
+
+// Tempo por consulta [ns]; soma de Ey em sum para o laço não ser descartado
+double Time(Garfield::Sensor& sensor, const std::vector<Point>& path, double& sum) {
+  double ex = 0., ey = 0., ez = 0.;
+  Garfield::Medium* medium = nullptr;
+  int status = 0;
+  sum = 0.;
+  const auto start = std::chrono::steady_clock::now();
+  for (const Point& p : path) {
+    sensor.ElectricField(p.x, p.y, p.z, ex, ey, ez, medium, status);
+    sum += ey;
+  }
+  const double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return 1e9 * t / path.size();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::size_t nSteps = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+  const double pitch = argc > 2 ? std::atof(argv[2]) : 0.5;
+  const auto path = MakePath(nSteps);
+
+  Garfield::MediumMagboltz gas;
+
+  Garfield::ComponentAnalyticField analytic;
+  analytic.SetMedium(&gas);
+  analytic.AddPlaneY(-0.5 * kGap, 0., "anode");
+  analytic.AddPlaneY(+0.5 * kGap, -kHV, "cathode");
+
+  ComponentUniformGap uniform;
+  uniform.SetPlates(ParallelPlates{-0.5 * kGap, +0.5 * kGap, 0., -kHV});
+  uniform.SetMedium(&gas);
+
+  ComponentGapFieldMap map;
+  const int nx = 1 + static_cast<int>(std::ceil(2 * kHalfX / pitch));
+  const int nz = 1 + static_cast<int>(std::ceil(2 * kHalfZ / pitch));
+  map.Build(analytic, -kHalfX, -0.5 * kGap, -kHalfZ, kHalfX, 0.5 * kGap, kHalfZ, nx, 21, nz);
+  map.SetMedium(&gas);
+
+  Garfield::Sensor sensorAnalytic, sensorUniform, sensorMap;
+  sensorAnalytic.AddComponent(&analytic);
+  sensorUniform.AddComponent(&uniform);
+  sensorMap.AddComponent(&map);
+  SetArea(sensorAnalytic);
+  SetArea(sensorUniform);
+  SetArea(sensorMap);
+
+  double sumAnalytic = 0., sumUniform = 0., sumMap = 0.;
+  const double tAnalytic = Time(sensorAnalytic, path, sumAnalytic);
+  const double tUniform = Time(sensorUniform, path, sumUniform);
+  const double tMap = Time(sensorMap, path, sumMap);
+
+  // Diferença relativa máxima de Ey em relação ao analytic
+  double maxUniform = 0., maxMap = 0.;
+  for (std::size_t i = 0; i < path.size(); i += 97) {
+    const Point& p = path[i];
+    double ex, ey, ez, eyRef;
+    Garfield::Medium* medium = nullptr;
+    int status = 0;
+    sensorAnalytic.ElectricField(p.x, p.y, p.z, ex, eyRef, ez, medium, status);
+    sensorUniform.ElectricField(p.x, p.y, p.z, ex, ey, ez, medium, status);
+    maxUniform = std::max(maxUniform, std::abs(ey - eyRef) / std::abs(eyRef));
+    sensorMap.ElectricField(p.x, p.y, p.z, ex, ey, ez, medium, status);
+    maxMap = std::max(maxMap, std::abs(ey - eyRef) / std::abs(eyRef));
+  }
+
+  const bool same = maxUniform < 1e-9 && maxMap < 1e-6;
+  std::printf("passos %zu, gap %.2f cm, %.0f V, mapa %d x 21 x %d (%.1f MB)\n", nSteps, kGap, kHV, nx, nz,
+              map.GetMemoryUsage() / (1024. * 1024.));
+  std::printf("analytic: %6.2f ns/passo\n", tAnalytic);
+  std::printf("uniform:  %6.2f ns/passo  (%.1fx, |dEy/Ey| máx %.1e)\n", tUniform, tAnalytic / tUniform, maxUniform);
+  std::printf("map:      %6.2f ns/passo  (%.1fx, |dEy/Ey| máx %.1e)\n", tMap, tAnalytic / tMap, maxMap);
+  std::printf("somas de Ey: %.6e %.6e %.6e, campos %s\n", sumAnalytic, sumUniform, sumMap,
+              same ? "compatíveis" : "DIFERENTES");
+  return same ? 0 : 1;
+}
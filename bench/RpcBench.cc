@@ -0,0 +1,110 @@
+// Benchmark da simulação completa. Cada execução roda uma configuração
+// (macro que fixa sementes, partícula, energia, número de threads e o modo
+// do Garfield++, sem /run/initialize nem /run/beamOn) e acrescenta uma linha
+// ao CSV:
+//   config, threads, events, warmup, init_s, run_s, events_per_s, peak_rss_mb
+//
+// init_s inclui /run/initialize e os eventos de aquecimento (tabelas de
+// física do Geant4, gás, campo e tabelas do Garfield++); run_s é só o run
+// medido.
+//
+// threads, se dado, troca o /run/numberOfThreads da macro (a mesma
+// configuração medida com 1 e N threads fica em duas linhas do CSV).
+//
+// Uso: rpc_bench <config.mac> [eventos=200] [aquecimento=5] [csv=rpc_bench.csv] [threads]
+
+#include <sys/resource.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "G4RunManagerFactory.hh"
+#include "G4UImanager.hh"
+
+#include "ActionInitialization.hh"
+#include "DetectorConstruction.hh"
+#include "GunMessenger.hh"
+#include "LogMessenger.hh"
+#include "OutputMessenger.hh"
+#include "PhysicsList.hh"
+#include "ProfilerMessenger.hh"
+
+namespace {
+
+double PeakRssMB() {
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.;
+  return usage.ru_maxrss / 1024.;  // Linux: kB
+}
+
+std::string ConfigName(const std::string& macro) {
+  std::string name = macro.substr(macro.find_last_of('/') + 1);
+  const std::size_t dot = name.find_last_of('.');
+  return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::fprintf(stderr, "Uso: %s <config.mac> [eventos=200] [aquecimento=5] [csv=rpc_bench.csv] [threads]\n",
+                 argv[0]);
+    return 1;
+  }
+  const std::string macro = argv[1];
+  const int nEvents = argc > 2 ? std::atoi(argv[2]) : 200;
+  const int nWarmup = argc > 3 ? std::atoi(argv[3]) : 5;
+  const std::string csv = argc > 4 ? argv[4] : "rpc_bench.csv";
+  const int threadsOverride = argc > 5 ? std::atoi(argv[5]) : 0;
+
+  auto* runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default);
+  runManager->SetUserInitialization(new DetectorConstruction());
+  runManager->SetUserInitialization(new PhysicsList());
+  runManager->SetUserInitialization(new ActionInitialization());
+
+  LogMessenger* logMessenger = new LogMessenger();
+  OutputMessenger* outputMessenger = new OutputMessenger();
+  GunMessenger* gunMessenger = new GunMessenger();
+  ProfilerMessenger* profilerMessenger = new ProfilerMessenger();
+
+  G4UImanager* UImanager = G4UImanager::GetUIpointer();
+  if (UImanager->ApplyCommand("/control/execute " + macro) != 0) {
+    std::fprintf(stderr, "rpc_bench: falha ao executar %s\n", macro.c_str());
+    return 1;
+  }
+  if (threadsOverride > 0) {
+    UImanager->ApplyCommand("/run/numberOfThreads " + std::to_string(threadsOverride));
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const auto initStart = Clock::now();
+  UImanager->ApplyCommand("/run/initialize");
+  if (nWarmup > 0) UImanager->ApplyCommand("/run/beamOn " + std::to_string(nWarmup));
+  const double initTime = std::chrono::duration<double>(Clock::now() - initStart).count();
+
+  const auto runStart = Clock::now();
+  UImanager->ApplyCommand("/run/beamOn " + std::to_string(nEvents));
+  const double runTime = std::chrono::duration<double>(Clock::now() - runStart).count();
+
+  const int nThreads = runManager->GetNumberOfThreads();
+  const double rate = runTime > 0. ? nEvents / runTime : 0.;
+  const double rss = PeakRssMB();
+
+  const bool newFile = !std::ifstream(csv).good();
+  std::ofstream out(csv, std::ios::app);
+  if (newFile) out << "config,threads,events,warmup,init_s,run_s,events_per_s,peak_rss_mb\n";
+  out << ConfigName(macro) << ',' << nThreads << ',' << nEvents << ',' << nWarmup << ',' << initTime << ','
+      << runTime << ',' << rate << ',' << rss << '\n';
+
+  std::printf("rpc_bench %s: %d threads, init %.2f s, %d eventos em %.2f s (%.2f eventos/s), pico RSS %.1f MB -> %s\n",
+              ConfigName(macro).c_str(), nThreads, initTime, nEvents, runTime, rate, rss, csv.c_str());
+
+  delete runManager;
+  delete profilerMessenger;
+  delete gunMessenger;
+  delete outputMessenger;
+  delete logMessenger;
+  return 0;
+}
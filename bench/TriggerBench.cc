@@ -0,0 +1,101 @@
+// Microbenchmark da consulta por step do FastSimulationModel::ModelTrigger:
+//   - referência: nome da partícula copiado para uma string e procurado no
+//     std::map<std::string, pair> (como FindParticleNameEnergy fazia);
+//   - tabela: ApplicabilityTable indexada pelo índice da partícula.
+// Não depende do Geant4: as "definições" são structs com nome e índice, na
+// ordem em que o Geant4 cria as partículas mais comuns.
+//
+// Uso: rpc_bench_trigger [steps]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ApplicabilityTable.hh"
+
+namespace {
+
+struct Definition {
+  std::string name;
+  int index;
+};
+
+using RangeMap = std::map<std::string, std::pair<double, double>>;
+
+// Mesma assinatura da versão antiga (argumentos por valor)
+bool FindParticleNameEnergy(const RangeMap& ranges, std::string name, double ekin_MeV,
+                            std::string program) {
+  if (program == "garfield") {
+    auto it = ranges.find(name);
+    if (it != ranges.end()) {
+      return it->second.first <= ekin_MeV && it->second.second >= ekin_MeV;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const long nSteps = argc > 1 ? std::atol(argv[1]) : 20000000;
+
+  // Intervalos do modo Heed (Physics.cc)
+  const RangeMap ranges = {
+      {"gamma", {1e-6, 1e+8}},     {"e-", {6e-2, 1e+7}},       {"e+", {6e-2, 1e+7}},
+      {"mu-", {1e+1, 1e+8}},       {"mu+", {1e+1, 1e+8}},      {"pi-", {2e+1, 1e+8}},
+      {"pi+", {2e+1, 1e+8}},       {"kaon-", {1e+1, 1e+8}},    {"kaon+", {1e+1, 1e+8}},
+      {"proton", {9.e+1, 1e+8}},   {"anti_proton", {9.e+1, 1e+8}},
+      {"deuteron", {2.e+2, 1e+8}}, {"alpha", {4.e+2, 1e+8}}};
+
+  std::vector<Definition> definitions;
+  for (const char* name : {"gamma", "e-", "e+", "mu-", "mu+", "pi-", "pi+", "kaon-", "kaon+",
+                           "proton", "anti_proton", "neutron", "deuteron", "alpha", "GenericIon"}) {
+    definitions.push_back({name, static_cast<int>(definitions.size())});
+  }
+
+  ApplicabilityTable table;
+  for (const auto& definition : definitions) {
+    auto it = ranges.find(definition.name);
+    if (it != ranges.end()) table.Set(definition.index, it->second.first, it->second.second, definition.name);
+  }
+
+  // Steps no gás: maioria de múons, depois elétrons delta e fótons
+  std::mt19937_64 rng(7);
+  std::discrete_distribution<int> pick({10, 30, 2, 50, 5, 1, 1, 0.2, 0.2, 0.5, 0.05, 0.5, 0.02, 0.02, 0.01});
+  std::uniform_real_distribution<double> logE(-3., 5.);
+  const std::size_t nPool = 4096;
+  std::vector<const Definition*> particles(nPool);
+  std::vector<double> energies(nPool);
+  for (std::size_t i = 0; i < nPool; ++i) {
+    particles[i] = &definitions[pick(rng)];
+    energies[i] = std::pow(10., logE(rng));
+  }
+
+  long refHits = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < nSteps; ++i) {
+    const std::size_t k = i & (nPool - 1);
+    std::string particleName = particles[k]->name;
+    refHits += FindParticleNameEnergy(ranges, particleName, energies[k], "garfield");
+  }
+  const double tRef = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  long tableHits = 0;
+  start = std::chrono::steady_clock::now();
+  for (long i = 0; i < nSteps; ++i) {
+    const std::size_t k = i & (nPool - 1);
+    tableHits += table.IsApplicable(particles[k]->index, energies[k]);
+  }
+  const double tTable = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::printf("steps %ld, aceitos %ld\n", nSteps, refHits);
+  std::printf("mapa por nome: %8.3f ms  (%.2f ns/step)\n", 1e3 * tRef, 1e9 * tRef / nSteps);
+  std::printf("tabela:        %8.3f ms  (%.2f ns/step)\n", 1e3 * tTable, 1e9 * tTable / nSteps);
+  std::printf("speedup %.1fx, resultados %s\n", tRef / tTable, refHits == tableHits ? "idênticos" : "DIFERENTES");
+  return refHits == tableHits ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+#ifndef AllocationCounter_h
+#define AllocationCounter_h
+
+#include <cstdint>
+
+// Contagem de alocações no heap feitas pelo nosso código durante o evento,
+// para conferir que, passado o aquecimento, o caminho por evento (DoIt,
+// leitura dos pads, saída) não aloca mais nada.
+//
+// Só existe com -DRPC_COUNT_ALLOCATIONS=ON: o AllocationCounter.cc troca o
+// operator new e conta, por thread, as alocações feitas dentro de um
+// Tracked e fora de um External (chamadas ao Garfield++ e ao
+// G4AnalysisManager, que alocam por conta própria). Sem a opção as classes
+// são vazias e as funções não fazem nada.
+class AllocationCounter {
+ public:
+#ifdef RPC_COUNT_ALLOCATIONS
+  class Tracked {
+   public:
+    Tracked() { ++fTrackedDepth; }
+    ~Tracked() { --fTrackedDepth; }
+  };
+  class External {
+   public:
+    External() { ++fExternalDepth; }
+    ~External() { --fExternalDepth; }
+  };
+
+  static bool IsEnabled() { return true; }
+  static void Count() {
+    if (fTrackedDepth > 0 && fExternalDepth == 0) ++fEventCount;
+  }
+  // Fecha o evento da thread: guarda as alocações dele nas estatísticas do run.
+  static void EndEvent();
+  // Escreve as estatísticas do run da thread e as zera.
+  static void Report();
+
+ private:
+  static thread_local int fTrackedDepth;
+  static thread_local int fExternalDepth;
+  static thread_local std::uint64_t fEventCount;
+#else
+  class Tracked {
+   public:
+    Tracked() {}
+    ~Tracked() {}
+  };
+  class External {
+   public:
+    External() {}
+    ~External() {}
+  };
+
+  static bool IsEnabled() { return false; }
+  static void EndEvent() {}
+  static void Report() {}
+#endif
+};
+
+#endif
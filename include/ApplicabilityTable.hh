@@ -0,0 +1,52 @@
+#ifndef ApplicabilityTable_h
+#define ApplicabilityTable_h
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Tabela de aplicabilidade de um modelo (Heed ou PAI) indexada pelo índice
+// da partícula (G4ParticleDefinition::GetInstanceID(), contíguo a partir de
+// 0). Montada uma vez na inicialização a partir dos mapas por nome do
+// GarfieldPhysics; a consulta por step é um acesso a um vetor.
+class ApplicabilityTable {
+ public:
+  struct Entry {
+    bool applicable = false;
+    double eMin = 0.;      // energia cinética [unidades do Geant4]
+    double eMax = 0.;
+    std::string heedName;  // nome da partícula no TrackHeed
+
+    bool Contains(double ekin) const { return eMin <= ekin && ekin <= eMax; }
+  };
+
+  void Clear() { fEntries.clear(); }
+  void Set(int index, double eMin, double eMax, const std::string& heedName) {
+    if (index < 0) return;
+    if (static_cast<std::size_t>(index) >= fEntries.size()) fEntries.resize(index + 1);
+    Entry& entry = fEntries[index];
+    entry.applicable = true;
+    entry.eMin = eMin;
+    entry.eMax = eMax;
+    entry.heedName = heedName;
+  }
+
+  // nullptr se o modelo não se aplica à partícula
+  const Entry* Find(int index) const {
+    if (index < 0 || static_cast<std::size_t>(index) >= fEntries.size()) return nullptr;
+    const Entry& entry = fEntries[index];
+    return entry.applicable ? &entry : nullptr;
+  }
+  bool IsApplicable(int index) const { return Find(index) != nullptr; }
+  bool IsApplicable(int index, double ekin) const {
+    const Entry* entry = Find(index);
+    return entry && entry->Contains(ekin);
+  }
+
+  std::size_t Size() const { return fEntries.size(); }
+
+ private:
+  std::vector<Entry> fEntries;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef AvalancheTable_h
+#define AvalancheTable_h
+
+#include <string>
+#include <vector>
+
+namespace Garfield {
+class AvalancheMC;
+}
+
+// Resposta parametrizada de uma avalanche em função da profundidade y em que
+// o elétron primário começa no gap. Para cada fatia em y guardamos os quantis
+// do tamanho da avalanche, o tempo de chegada (média e sigma) e o
+// espalhamento lateral, de modo que o drift de cada elétron vire uma consulta
+// à tabela mais alguns números aleatórios.
+class AvalancheTable {
+ public:
+  // Tudo o que muda a resposta da avalanche; uma tabela salva só é aceita
+  // se a chave inteira coincide.
+  struct Key {
+    double gap = 0.;         // [cm]
+    double hv = 0.;          // [V]
+    double stepSize = 0.;    // [cm]
+    double temperature = 0.; // [K]
+    double pressure = 0.;    // [Torr]
+    std::string gasFile;
+    std::string composition; // p.ex. "ic4h10 5 sf6 5 c2h2f4 90"
+    std::string fieldModel;  // p.ex. "uniform", "map 1 11"
+  };
+
+  struct Result {
+    double size = 0.;
+    double t = 0.;           // [ns]
+    double x = 0.;           // [cm]
+    double y = 0.;           // [cm]
+    double z = 0.;           // [cm]
+  };
+
+  AvalancheTable() = default;
+
+  // Amostra nSamples avalanches em cada uma das nBins fatias de [yMin, yMax].
+  void Build(Garfield::AvalancheMC& avalanche, const Key& key, double yMin,
+             double yMax, int nBins, int nSamples, int nQuantiles = 64);
+
+  bool Load(const std::string& fileName, const Key& key);
+  bool Save(const std::string& fileName) const;
+
+  bool IsValid() const { return !fBins.empty(); }
+  int GetNumberOfBins() const { return static_cast<int>(fBins.size()); }
+
+  // Usa o gerador do Geant4 da thread corrente.
+  Result Sample(double x, double y, double z, double t) const;
+
+ private:
+  struct Bin {
+    std::vector<double> quantiles;
+    double tMean = 0.;
+    double tSigma = 0.;
+    double lateralSigma = 0.;
+    double yEnd = 0.;
+  };
+
+  Key fKey;
+  double fYMin = 0.;
+  double fYMax = 0.;
+  std::vector<Bin> fBins;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef ComponentGapFieldMap_h
+#define ComponentGapFieldMap_h
+
+#include <cstddef>
+#include <vector>
+#include "Garfield/Component.hh"
+
+// Mapa 3D do campo do gap, amostrado uma vez de outro componente em uma
+// grade regular e interpolado trilinearmente. É o caminho para variantes não
+// uniformes do gap (espaçadores, bordas), cujo componente de origem é caro
+// demais para ser consultado a cada passo do AvalancheMC.
+//
+// Cada nó guarda (Ex, Ey, Ez, V) em float, alinhado a 16 bytes: a
+// interpolação trata os quatro valores juntos, um registro SSE por nó,
+// quando disponível. Fora da grade não há meio (status -6). Unidades do
+// Garfield++ (cm, V, V/cm).
+class ComponentGapFieldMap : public Garfield::Component {
+ public:
+  ComponentGapFieldMap() : Garfield::Component("GapFieldMap") {}
+  ~ComponentGapFieldMap() override = default;
+
+  // nx x ny x nz nós (>= 2 por eixo) cobrindo a caixa, inclusive as bordas
+  bool Build(Garfield::Component& source,
+             double xmin, double ymin, double zmin,
+             double xmax, double ymax, double zmax,
+             int nx, int ny, int nz);
+  void SetMedium(Garfield::Medium* medium) { fMedium = medium; }
+  std::size_t GetMemoryUsage() const { return fNodes.size() * sizeof(Node); }
+
+  void ElectricField(const double x, const double y, const double z,
+                     double& ex, double& ey, double& ez,
+                     Garfield::Medium*& m, int& status) override;
+  void ElectricField(const double x, const double y, const double z,
+                     double& ex, double& ey, double& ez, double& v,
+                     Garfield::Medium*& m, int& status) override;
+  Garfield::Medium* GetMedium(const double x, const double y, const double z) override;
+  bool GetVoltageRange(double& vmin, double& vmax) override;
+  bool GetBoundingBox(double& xmin, double& ymin, double& zmin,
+                      double& xmax, double& ymax, double& zmax) override;
+
+ protected:
+  void Reset() override;
+  void UpdatePeriodicity() override {}
+
+ private:
+  struct alignas(16) Node {
+    float f[4];  // Ex, Ey, Ez, V
+  };
+
+  bool Inside(double x, double y, double z) const {
+    return x >= fMin[0] && x <= fMax[0] && y >= fMin[1] && y <= fMax[1] &&
+           z >= fMin[2] && z <= fMax[2];
+  }
+  // Interpola os quatro valores do nó; o ponto precisa estar na grade
+  void Interpolate(double x, double y, double z, float out[4]) const;
+
+  std::vector<Node> fNodes;  // [(ix * ny + iy) * nz + iz]
+  int fN[3] = {0, 0, 0};
+  double fMin[3] = {0., 0., 0.};
+  double fMax[3] = {-1., -1., -1.};
+  double fInvStep[3] = {0., 0., 0.};
+  double fVMin = 0.;
+  double fVMax = 0.;
+  Garfield::Medium* fMedium = nullptr;
+};
+
+#endif
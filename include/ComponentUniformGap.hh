@@ -0,0 +1,74 @@
+#ifndef ComponentUniformGap_h
+#define ComponentUniformGap_h
+
+#include "Garfield/Component.hh"
+
+// Placas paralelas normais a y, com o potencial linear entre elas.
+// Unidades do Garfield++ (cm, V, V/cm).
+struct ParallelPlates {
+  double yAnode;
+  double yCathode;
+  double vAnode;
+  double vCathode;
+
+  constexpr double Ey() const { return (vAnode - vCathode) / (yCathode - yAnode); }
+  constexpr double Potential(double y) const { return vAnode - Ey() * (y - yAnode); }
+  constexpr double YMin() const { return yAnode < yCathode ? yAnode : yCathode; }
+  constexpr double YMax() const { return yAnode < yCathode ? yCathode : yAnode; }
+};
+
+// Campo do gap de placas paralelas sem passar pela montagem de célula do
+// ComponentAnalyticField: entre as placas o campo é a constante Ey e o meio é
+// o único meio do gap, então cada consulta do AvalancheMC (uma por passo) é
+// uma comparação em y. Fora das placas não há meio (status -6), o que termina
+// o drift como no ComponentAnalyticField. Sem periodicidade e sem campo de
+// ponderação (os pads usam o WeightingPotentialTable).
+class ComponentUniformGap : public Garfield::Component {
+ public:
+  ComponentUniformGap() : Garfield::Component("UniformGap") {}
+  ~ComponentUniformGap() override = default;
+
+  void SetPlates(const ParallelPlates& plates);
+  void SetMedium(Garfield::Medium* medium) { fMedium = medium; }
+  const ParallelPlates& GetPlates() const { return fPlates; }
+
+  void ElectricField(const double x, const double y, const double z,
+                     double& ex, double& ey, double& ez,
+                     Garfield::Medium*& m, int& status) override {
+    ex = ez = 0.;
+    if (y >= fYMin && y <= fYMax) {
+      ey = fEy;
+      m = fMedium;
+      status = 0;
+    } else {
+      ey = 0.;
+      m = nullptr;
+      status = -6;
+    }
+  }
+  void ElectricField(const double x, const double y, const double z,
+                     double& ex, double& ey, double& ez, double& v,
+                     Garfield::Medium*& m, int& status) override {
+    ElectricField(x, y, z, ex, ey, ez, m, status);
+    v = status == 0 ? fPlates.Potential(y) : 0.;
+  }
+  Garfield::Medium* GetMedium(const double x, const double y, const double z) override {
+    return y >= fYMin && y <= fYMax ? fMedium : nullptr;
+  }
+  bool GetVoltageRange(double& vmin, double& vmax) override;
+  bool GetBoundingBox(double& xmin, double& ymin, double& zmin,
+                      double& xmax, double& ymax, double& zmax) override;
+
+ protected:
+  void Reset() override;
+  void UpdatePeriodicity() override {}
+
+ private:
+  ParallelPlates fPlates{0., 0., 0., 0.};
+  double fEy = 0.;
+  double fYMin = 0.;
+  double fYMax = -1.;
+  Garfield::Medium* fMedium = nullptr;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef CosmicMuonSpectrum_h
+#define CosmicMuonSpectrum_h
+
+#include <vector>
+
+// Espectro de momento dos múons cósmicos ao nível do mar (parametrização de
+// Reyna, a partir de Bugaev et al.):
+//   I(p, theta) = cos^3(theta) * I_V(p cos(theta))
+//   I_V(xi) = c1 * xi^-(c2 + c3 y + c4 y^2 + c5 y^3),  y = log10(xi / GeV/c)
+// em cm^-2 s^-1 sr^-1 (GeV/c)^-1. Com xi = p cos(theta) a dependência angular
+// integrada em p é cos^2(theta), então o gerador sorteia theta e xi de forma
+// independente e faz p = xi / cos(theta).
+//
+// I_V é tabelado em log(xi) entre pMin e pMax e sorteado pela inversa da
+// distribuição acumulada. Valores em unidades do Geant4.
+class CosmicMuonSpectrum {
+ public:
+  void Build(double pMin, double pMax);
+  bool IsBuilt() const { return !fCumulative.empty(); }
+
+  // xi = p cos(theta) para u em [0, 1)
+  double SampleVerticalMomentum(double u) const;
+  // Integral de I_V entre pMin e pMax [1/(área tempo ângulo sólido)]
+  double GetIntegratedVerticalIntensity() const { return fIntegral; }
+
+  static double VerticalIntensity(double p);
+
+ private:
+  std::vector<double> fLogP;
+  std::vector<double> fCumulative;
+  double fIntegral = 0.;
+};
+
+#endif
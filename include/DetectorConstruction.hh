@@ -3,13 +3,17 @@
 
 #include "G4VUserDetectorConstruction.hh"
 #include "globals.hh"
+#include "G4LogicalVolume.hh"
+#include "DetectorLayer.hh"
+#include <vector>
 
 class G4VPhysicalVolume;
-class G4LogicalVolume;
 class G4Material;
 class G4Region; 
 class GarfieldG4FastSimulationModel;
 class GarfieldMessenger;
+class DetectorMessenger;
+class ReadoutMessenger;
 
 class DetectorConstruction : public G4VUserDetectorConstruction {
 public:
@@ -18,9 +22,18 @@ public:
     virtual G4VPhysicalVolume *Construct() override;
     virtual void ConstructSDandField() override;
 
+    // Camada (DetectorLayer) de um volume lógico, por índice do volume: é
+    // consultada a cada step, então não compara nomes. Refeita a cada
+    // Construct(); entre runs, quando as threads estão paradas.
+    G4int GetLayer(const G4LogicalVolume* volume) const {
+        const std::size_t id = static_cast<std::size_t>(volume->GetInstanceID());
+        return id < fLayerOfVolume.size() ? fLayerOfVolume[id] : DetectorLayer::kNone;
+    }
+
 private:
     void DefineMaterials();
     G4VPhysicalVolume* DefineVolumes();
+    void SetLayer(const G4LogicalVolume* volume, G4int layer);
     
     G4LogicalVolume* logicPad = nullptr;
     G4Material* fPadMaterial = nullptr;
@@ -29,9 +42,13 @@ private:
     G4bool fCheckOverlaps = true; 
     
     
+    std::vector<G4int> fLayerOfVolume;
+
     G4Region* fGasRegion = nullptr;
     GarfieldG4FastSimulationModel* fGarfieldG4FastSimulationModel = nullptr;
     GarfieldMessenger* fGarfieldMessenger = nullptr;
+    DetectorMessenger* fDetectorMessenger = nullptr;
+    ReadoutMessenger* fReadoutMessenger = nullptr;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef DetectorLayer_h
+#define DetectorLayer_h
+
+#include <array>
+
+// Camadas passivas do empilhamento da RPC, para as somas por camada do
+// SteppingAction e as colunas E<camada>/L<camada> do ntuple. O gás fica fora
+// dos arrays (a energia nele vem do Garfield++).
+namespace DetectorLayer {
+  enum Layer { kAluminium = 0, kPads, kAcrylic, kGraphite, kGlass, kNumberOfLayers };
+
+  // Classificação de um volume lógico: uma camada, o gás ou nenhum (mundo)
+  constexpr int kGas = kNumberOfLayers;
+  constexpr int kNone = -1;
+
+  inline const char* Name(int layer) {
+    static const char* const names[] = {"Al", "Pads", "Acrylic", "Graphite", "Glass"};
+    return names[layer];
+  }
+
+  using Sums = std::array<double, kNumberOfLayers>;
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef DetectorMessenger_h
+#define DetectorMessenger_h
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+
+// Comandos /rpc/detector/... sobre o DetectorParameters. Mudanças de
+// geometria pedem a reconstrução ao G4RunManager; a tensão só é aplicada pelo
+// GarfieldPhysics no próximo run.
+class DetectorMessenger : public G4UImessenger {
+ public:
+  DetectorMessenger();
+  ~DetectorMessenger() override;
+
+  void SetNewValue(G4UIcommand*, G4String) override;
+  G4String GetCurrentValue(G4UIcommand*) override;
+
+ private:
+  G4UIcmdWithADoubleAndUnit* MakeLengthCommand(const char* path, const char* guidance);
+
+  G4UIdirectory* fDetectorDir = nullptr;
+  G4UIcmdWithADoubleAndUnit* fGapCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fGlassThicknessCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fGraphiteThicknessCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fSizeXCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fSizeZCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fPadSizeXCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fPadSizeZCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fPadBorderCmd = nullptr;
+  G4UIcmdWithAnInteger* fNPadsXCmd = nullptr;
+  G4UIcmdWithAnInteger* fNPadsZCmd = nullptr;
+  G4UIcmdWithAnInteger* fGapsPerChamberCmd = nullptr;
+  G4UIcmdWithAnInteger* fNChambersCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fChamberSpacingCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fHighVoltageCmd = nullptr;
+  G4UIcmdWithoutParameter* fPrintCmd = nullptr;
+};
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef DetectorParameters_h
+#define DetectorParameters_h
+
+#include "CLHEP/Units/SystemOfUnits.h"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+// Descrição única da câmara: DetectorConstruction, GarfieldPhysics (Sensor,
+// planos do ComponentAnalyticField e corte de aceitação) e o gerador leem
+// daqui. Os valores estão em unidades do Geant4 e só mudam no master, entre
+// runs (DetectorMessenger); as threads leem no início de cada run.
+//
+// Pilha de camadas de uma câmara, de cima para baixo:
+//   Al | pads | acrílico | grafite | vidro | gás | vidro | grafite | acrílico | Al
+// Com n gaps por câmara os gaps são separados por vidros flutuantes
+// (vidro | gás | vidro | gás | ... | vidro, n + 1 vidros). As M câmaras são
+// empilhadas em y, a uma distância GetChamberSpacing() entre o alumínio de
+// uma e o da outra. Câmaras e gaps são numerados de baixo para cima, como as
+// cópias do G4PVReplica; o índice global do gap é câmara * n + gap.
+class DetectorParameters {
+ public:
+  static DetectorParameters* Instance();
+
+  // Dimensões transversais (x, z) da câmara: alumínio e volume de gás
+  G4double GetSizeX() const { return fSizeX; }
+  G4double GetSizeZ() const { return fSizeZ; }
+  void SetSizeX(G4double value) { fSizeX = value; GeometryChanged(); }
+  void SetSizeZ(G4double value) { fSizeZ = value; GeometryChanged(); }
+
+  G4double GetGasGap() const { return fGasGap; }
+  G4double GetGlassThickness() const { return fGlassThickness; }
+  G4double GetGraphiteThickness() const { return fGraphiteThickness; }
+  G4double GetAcrylicThickness() const { return fAcrylicThickness; }
+  G4double GetAluminiumThickness() const { return fAluminiumThickness; }
+  G4double GetPadThickness() const { return fPadThickness; }
+  void SetGasGap(G4double value) { fGasGap = value; FieldChanged(); }
+  void SetGlassThickness(G4double value) { fGlassThickness = value; GeometryChanged(); }
+  void SetGraphiteThickness(G4double value) { fGraphiteThickness = value; GeometryChanged(); }
+  void SetAcrylicThickness(G4double value) { fAcrylicThickness = value; GeometryChanged(); }
+  void SetAluminiumThickness(G4double value) { fAluminiumThickness = value; GeometryChanged(); }
+  void SetPadThickness(G4double value) { fPadThickness = value; GeometryChanged(); }
+
+  G4double GetGlassSizeX() const { return fGlassSizeX; }
+  G4double GetGlassSizeZ() const { return fGlassSizeZ; }
+  G4double GetGraphiteSizeX() const { return fGraphiteSizeX; }
+  G4double GetGraphiteSizeZ() const { return fGraphiteSizeZ; }
+  G4double GetAcrylicSizeX() const { return fAcrylicSizeX; }
+  G4double GetAcrylicSizeZ() const { return fAcrylicSizeZ; }
+
+  // Matriz de pads: passo = tamanho do pad + borda
+  G4double GetPadSizeX() const { return fPadSizeX; }
+  G4double GetPadSizeZ() const { return fPadSizeZ; }
+  G4double GetPadBorder() const { return fPadBorder; }
+  G4int GetNumberOfPadsX() const { return fNPadsX; }
+  G4int GetNumberOfPadsZ() const { return fNPadsZ; }
+  G4double GetPadPitchX() const { return fPadSizeX + fPadBorder; }
+  G4double GetPadPitchZ() const { return fPadSizeZ + fPadBorder; }
+  void SetPadSizeX(G4double value) { fPadSizeX = value; GeometryChanged(); }
+  void SetPadSizeZ(G4double value) { fPadSizeZ = value; GeometryChanged(); }
+  void SetPadBorder(G4double value) { fPadBorder = value; GeometryChanged(); }
+  void SetNumberOfPadsX(G4int value) { fNPadsX = value; GeometryChanged(); }
+  void SetNumberOfPadsZ(G4int value) { fNPadsZ = value; GeometryChanged(); }
+
+  // Empilhamento: gaps por câmara, número de câmaras e o espaço entre elas
+  G4int GetGapsPerChamber() const { return fGapsPerChamber; }
+  G4int GetNumberOfChambers() const { return fNChambers; }
+  G4double GetChamberSpacing() const { return fChamberSpacing; }
+  void SetGapsPerChamber(G4int value) { fGapsPerChamber = value; GeometryChanged(); }
+  void SetNumberOfChambers(G4int value) { fNChambers = value; GeometryChanged(); }
+  void SetChamberSpacing(G4double value) { fChamberSpacing = value; GeometryChanged(); }
+  G4int GetNumberOfGaps() const { return fGapsPerChamber * fNChambers; }
+  G4int GetGapIndex(G4int chamber, G4int gap) const { return chamber * fGapsPerChamber + gap; }
+
+  // Tensão aplicada ao catodo (o anodo fica em 0)
+  G4double GetHighVoltage() const { return fHighVoltage; }
+  // Só o campo: os Sensors e a tabela de ponderação continuam os mesmos
+  void SetHighVoltage(G4double value) { fHighVoltage = value; ++fFieldVersion; }
+
+  G4double GetWorldRadius() const { return fWorldRadius; }
+  void SetWorldRadius(G4double value) { fWorldRadius = value; GeometryChanged(); }
+
+  // Espessura de uma câmara, distância entre os centros de duas câmaras
+  // vizinhas e espessura total da pilha
+  G4double GetChamberThickness() const;
+  G4double GetChamberPitch() const { return GetChamberThickness() + fChamberSpacing; }
+  G4double GetTotalThickness() const;
+  // Centro de um gap no sistema da câmara e no mundo (índice global)
+  G4double GetGapOffset(G4int gap) const;
+  G4ThreeVector GetGapCenter(G4int index) const;
+  // Ponto médio entre o primeiro e o último gap; com um gap só, o centro dele
+  G4ThreeVector GetGasCenter() const;
+
+  // Incrementado a cada mudança, exceto de tensão; quem guarda uma cópia
+  // derivada (Sensor, tabela de ponderação) compara com a versão em que foi
+  // montada.
+  G4int GetVersion() const { return fVersion; }
+  // Gap, tensão e modelo do campo mudam o campo no gás (e a tabela de avalanche).
+  G4int GetFieldVersion() const { return fFieldVersion; }
+  // Também chamado quando muda o componente do campo (GarfieldPhysics::SetFieldModel)
+  void FieldChanged() { ++fVersion; ++fFieldVersion; }
+
+  void Print() const;
+
+ private:
+  DetectorParameters() = default;
+
+  void GeometryChanged() { ++fVersion; }
+
+  G4double fSizeX = 128.5 * CLHEP::cm;
+  G4double fSizeZ = 165.0 * CLHEP::cm;
+
+  G4double fGasGap = 0.2 * CLHEP::cm;
+  G4double fGlassThickness = 0.2 * CLHEP::cm;
+  G4double fGraphiteThickness = 1.0 * CLHEP::cm;
+  G4double fAcrylicThickness = 1.0 * CLHEP::cm;
+  G4double fAluminiumThickness = 2.5 * CLHEP::cm;
+  G4double fPadThickness = 0.5 * CLHEP::cm;
+
+  G4double fGlassSizeX = 120.0 * CLHEP::cm;
+  G4double fGlassSizeZ = 152.0 * CLHEP::cm;
+  G4double fGraphiteSizeX = 119.0 * CLHEP::cm;
+  G4double fGraphiteSizeZ = 148.5 * CLHEP::cm;
+  G4double fAcrylicSizeX = 125.0 * CLHEP::cm;
+  G4double fAcrylicSizeZ = 155.0 * CLHEP::cm;
+
+  G4double fPadSizeX = 14.0 * CLHEP::cm;
+  G4double fPadSizeZ = 18.0 * CLHEP::cm;
+  G4double fPadBorder = 1.0 * CLHEP::cm;
+  G4int fNPadsX = 8;
+  G4int fNPadsZ = 8;
+
+  G4int fGapsPerChamber = 1;
+  G4int fNChambers = 1;
+  G4double fChamberSpacing = 10.0 * CLHEP::cm;
+
+  G4double fHighVoltage = 6000. * CLHEP::volt;
+  G4double fWorldRadius = 1.5 * CLHEP::m;
+
+  G4int fVersion = 0;
+  G4int fFieldVersion = 0;
+};
+
+#endif
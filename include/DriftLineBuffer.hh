@@ -0,0 +1,105 @@
+#ifndef DriftLineBuffer_h
+#define DriftLineBuffer_h
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "G4ThreeVector.hh"
+
+struct DriftLine {
+  G4ThreeVector start;
+  G4ThreeVector end;
+};
+
+// Segmentos de drift do evento, para a visualização. Só aloca na primeira
+// linha guardada (em runs sem vis, nunca); como o ElectronBatch, a memória só
+// cresce: Clear() zera o contador e os elementos já alocados são
+// sobrescritos no evento seguinte.
+//
+// Decimação: guarda no máximo uma linha por célula cúbica de lado cellSize
+// (pelo ponto inicial) e no máximo maxLines por evento; as demais só são
+// contadas em GetDropped(). A ocupação das células é uma tabela de hash de
+// endereçamento aberto com a geração do evento em cada entrada, então Clear()
+// não percorre a tabela; ela fica no máximo meio cheia (kMaxCells células).
+class DriftLineBuffer {
+ public:
+  // cellSize <= 0 desliga a decimação espacial; maxLines = 0 não guarda nada
+  void Configure(std::size_t maxLines, double cellSize) {
+    fMaxLines = maxLines;
+    fInverseCell = cellSize > 0. ? 1. / cellSize : 0.;
+    std::size_t capacity = 64;
+    while (capacity < 2 * maxLines && capacity < 2 * kMaxCells) capacity *= 2;
+    if (capacity != fCellCapacity) {
+      fCellCapacity = capacity;
+      std::vector<Cell>().swap(fCells);
+    }
+  }
+  void Clear() {
+    fSize = 0;
+    fDropped = 0;
+    fClaimed = 0;
+    if (++fGeneration == 0) {
+      fCells.assign(fCells.size(), Cell());
+      fGeneration = 1;
+    }
+  }
+  // Retorna false se a linha foi descartada
+  bool Add(double x1, double y1, double z1, double x2, double y2, double z2) {
+    if (fSize >= fMaxLines || (fInverseCell > 0. && !Claim(x1, y1, z1))) {
+      ++fDropped;
+      return false;
+    }
+    if (fSize == fLines.size()) fLines.resize(fSize < 256 ? 256 : 2 * fSize);
+    DriftLine& line = fLines[fSize++];
+    line.start.set(x1, y1, z1);
+    line.end.set(x2, y2, z2);
+    return true;
+  }
+
+  std::size_t Size() const { return fSize; }
+  std::size_t GetDropped() const { return fDropped; }
+  const DriftLine* begin() const { return fLines.data(); }
+  const DriftLine* end() const { return fLines.data() + fSize; }
+
+ private:
+  static constexpr std::size_t kMaxCells = std::size_t(1) << 20;
+
+  struct Cell {
+    std::uint64_t key = 0;
+    std::uint32_t generation = 0;
+  };
+
+  // Marca a célula do ponto; false se ela já tem uma linha neste evento
+  bool Claim(double x, double y, double z) {
+    if (fCells.empty()) fCells.assign(fCellCapacity, Cell());
+    if (2 * fClaimed >= fCells.size()) return false;
+    auto index = [this](double v) {
+      return static_cast<std::uint64_t>(static_cast<std::int64_t>(std::floor(v * fInverseCell)) & 0x1fffff);
+    };
+    const std::uint64_t key = (index(x) << 42) | (index(y) << 21) | index(z);
+    const std::size_t mask = fCells.size() - 1;
+    for (std::size_t slot = ((key * 0x9e3779b97f4a7c15ULL) >> 40) & mask;; slot = (slot + 1) & mask) {
+      Cell& cell = fCells[slot];
+      if (cell.generation != fGeneration) {
+        cell.key = key;
+        cell.generation = fGeneration;
+        ++fClaimed;
+        return true;
+      }
+      if (cell.key == key) return false;
+    }
+  }
+
+  std::vector<DriftLine> fLines;
+  std::size_t fSize = 0;
+  std::size_t fDropped = 0;
+  std::size_t fMaxLines = static_cast<std::size_t>(-1);
+  double fInverseCell = 0.;
+  std::vector<Cell> fCells;
+  std::size_t fCellCapacity = 0;
+  std::size_t fClaimed = 0;
+  std::uint32_t fGeneration = 1;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef ElectronBatch_h
+#define ElectronBatch_h
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Caixa de aceitação no referencial local do gap [cm].
+struct AcceptanceBox {
+  double yMin;
+  double yMax;
+  double halfX;
+  double halfZ;
+};
+
+// Posições (clusters ou elétrons) em estrutura de arrays. O teste de
+// aceitação é feito sem desvios sobre arrays contíguos, dois elementos por vez
+// com SSE2 quando disponível; a capacidade dos vetores é mantida entre eventos.
+class ElectronBatch {
+ public:
+  void Clear() { fSize = 0; }
+  void Reserve(std::size_t n) {
+    if (n > fX.size()) Resize(n);
+  }
+  void Add(double x, double y, double z, double t) {
+    if (fSize == fX.size()) Resize(fSize < 64 ? 64 : 2 * fSize);
+    fX[fSize] = x;
+    fY[fSize] = y;
+    fZ[fSize] = z;
+    fT[fSize] = t;
+    ++fSize;
+  }
+
+  // Preenche a máscara de aceitação e retorna o número de aceitos.
+  std::size_t Accept(const AcceptanceBox& box) {
+    const std::size_t n = fSize;
+    const double* x = fX.data();
+    const double* y = fY.data();
+    const double* z = fZ.data();
+    unsigned char* accepted = fAccepted.data();
+    std::size_t nAccepted = 0;
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    const __m128d yMin = _mm_set1_pd(box.yMin);
+    const __m128d yMax = _mm_set1_pd(box.yMax);
+    const __m128d halfX = _mm_set1_pd(box.halfX);
+    const __m128d halfZ = _mm_set1_pd(box.halfZ);
+    const __m128d sign = _mm_set1_pd(-0.);
+    for (; i + 2 <= n; i += 2) {
+      const __m128d vy = _mm_loadu_pd(y + i);
+      const __m128d ax = _mm_andnot_pd(sign, _mm_loadu_pd(x + i));
+      const __m128d az = _mm_andnot_pd(sign, _mm_loadu_pd(z + i));
+      const __m128d in = _mm_and_pd(
+          _mm_and_pd(_mm_cmpge_pd(vy, yMin), _mm_cmple_pd(vy, yMax)),
+          _mm_and_pd(_mm_cmple_pd(ax, halfX), _mm_cmple_pd(az, halfZ)));
+      const int bits = _mm_movemask_pd(in);
+      accepted[i] = bits & 1;
+      accepted[i + 1] = bits >> 1;
+      nAccepted += (bits & 1) + (bits >> 1);
+    }
+#endif
+    for (; i < n; ++i) {
+      const unsigned char in = (y[i] >= box.yMin) & (y[i] <= box.yMax) &
+                               (std::abs(x[i]) <= box.halfX) &
+                               (std::abs(z[i]) <= box.halfZ);
+      accepted[i] = in;
+      nAccepted += in;
+    }
+    return nAccepted;
+  }
+
+  std::size_t Size() const { return fSize; }
+  bool IsAccepted(std::size_t i) const { return fAccepted[i] != 0; }
+  double X(std::size_t i) const { return fX[i]; }
+  double Y(std::size_t i) const { return fY[i]; }
+  double Z(std::size_t i) const { return fZ[i]; }
+  double T(std::size_t i) const { return fT[i]; }
+
+  const double* XData() const { return fX.data(); }
+  const double* YData() const { return fY.data(); }
+  const double* ZData() const { return fZ.data(); }
+  const unsigned char* AcceptedData() const { return fAccepted.data(); }
+
+ private:
+  void Resize(std::size_t n) {
+    fX.resize(n);
+    fY.resize(n);
+    fZ.resize(n);
+    fT.resize(n);
+    fAccepted.resize(n);
+  }
+
+  // Os vetores só crescem; fSize é o número de entradas do evento.
+  std::vector<double> fX, fY, fZ, fT;
+  std::vector<unsigned char> fAccepted;
+  std::size_t fSize = 0;
+};
+
+#endif
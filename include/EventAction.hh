@@ -3,24 +3,39 @@
 
 #include "G4UserEventAction.hh"
 #include "globals.hh"
+#include "DetectorLayer.hh"
+
+class RunAction;
 
 class EventAction : public G4UserEventAction
 {
   public:
-    EventAction();
+    EventAction(RunAction* runAction);
     virtual ~EventAction();
 
     virtual void BeginOfEventAction(const G4Event*);
     virtual void EndOfEventAction(const G4Event*);
 
-    void AddAbs(G4double de, G4double dl) { fEnergyAbs += de; fTrackLAbs += dl; }
+    // Fora do gás; layer é a camada do DetectorLayer ou kNone (mundo), que só
+    // entra no total
+    void AddAbs(G4int layer, G4double de, G4double dl) {
+      fEnergyAbs += de;
+      fTrackLAbs += dl;
+      if (layer >= 0) {
+        fEnergyLayer[layer] += de;
+        fTrackLayer[layer] += dl;
+      }
+    }
     void AddGas(G4double de) { fEnergyGas += de; }
 
   private:
+    RunAction* fRunAction;
     G4double fEnergyAbs;
     G4double fEnergyGas;
     G4double fTrackLAbs;
-    G4int    fAvalancheSize;
+    DetectorLayer::Sums fEnergyLayer{};
+    DetectorLayer::Sums fTrackLayer{};
+    G4double fAvalancheSize;
     G4double fGain;
 };
 
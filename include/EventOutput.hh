@@ -0,0 +1,106 @@
+#ifndef EventOutput_h
+#define EventOutput_h
+
+#include <atomic>
+#include <vector>
+#include "globals.hh"
+#include "PadReadout.hh"
+#include "DetectorLayer.hh"
+
+// Ntuple "Garfield": uma linha por evento, com as somas do evento em colunas
+// escalares (unidades do Geant4) e o detalhe em colunas vetoriais (unidades
+// do Garfield++: cm, ns, eV; carga em fC; posições no sistema local do gap
+// indicado em *Gap). Os grupos de
+// colunas e a precisão (float/double) são escolhidos em /rpc/output/... e
+// congelados quando o ntuple é criado, no início do primeiro run.
+//
+//   Eabs Labs Egas AvalancheSize Gain          sempre
+//   Run Event                                  sempre; o par de /rpc/replayEvent
+//   E{Al,Pads,...} L{Al,Pads,...}              energia e comprimento por camada
+//   Gap{E,AvalancheSize,Ne}                    um por gap da pilha
+//   Cluster{Gap,X,Y,Z,T,E,Ne}                  clusters aceitos no gap
+//   Avalanche{Gap,X,Y,Z,T,Ne}                  um por elétron primário
+//   Endpoint{X,Y,Z,T}                          pontos finais dos elétrons
+//   Pad{Id,Charge,ToT,LeadingEdge}             hits acima do limiar
+//
+// Uma instância por thread, do RunAction; o GarfieldPhysics da thread
+// acrescenta as entradas durante o evento e o EventAction grava a linha.
+class EventOutput {
+ public:
+  struct Schema {
+    bool layers = true;
+    bool gaps = true;
+    bool clusters = true;
+    bool avalanches = true;
+    bool endpoints = false;  // um por elétron da avalanche no modo full: volumoso
+    bool pads = true;
+    bool useFloat = true;
+    int compressionLevel = 1;
+    bool merge = true;
+  };
+  // Compartilhado; só muda no master, entre runs
+  static Schema& GetSchema();
+  static bool IsSchemaFrozen() { return fSchemaFrozen; }
+
+  // Tempo gasto em Write()/CloseFile() por todas as threads no run [s]
+  static void ResetWriteTime() { fWriteTime_ns = 0; }
+  static void AddWriteTime(double seconds) { fWriteTime_ns += static_cast<long long>(seconds * 1.e9); }
+  static double GetWriteTime() { return fWriteTime_ns * 1.e-9; }
+
+  // Cria o ntuple na primeira chamada; nas seguintes não faz nada.
+  void Book();
+  bool IsBooked() const { return fBooked; }
+
+  void Clear();
+  void AddGap(double energy, double avalancheSize, int nElectrons);
+  void AddCluster(int gap, double x, double y, double z, double t, double energy, int nElectrons);
+  void AddAvalanche(int gap, double x, double y, double z, double t, double size);
+  void AddEndpoint(double x, double y, double z, double t);
+
+  // Grava a linha do evento e esvazia as colunas vetoriais
+  void Fill(int run, int event, double eAbs, double lAbs, double eGas, double avalancheSize,
+            double gain, const DetectorLayer::Sums& eLayer, const DetectorLayer::Sums& lLayer,
+            const std::vector<PadHit>& padHits);
+
+ private:
+  // Coluna vetorial em float ou double, conforme o esquema
+  class VectorColumn {
+   public:
+    void Book(const G4String& name, bool useFloat);
+    void push_back(double value) {
+      if (fUseFloat) fFloat.push_back(static_cast<float>(value));
+      else fDouble.push_back(value);
+    }
+    void clear() {
+      fFloat.clear();
+      fDouble.clear();
+    }
+
+   private:
+    bool fUseFloat = true;
+    std::vector<float> fFloat;
+    std::vector<double> fDouble;
+  };
+
+  void FillScalar(G4int column, double value);
+
+  static std::atomic<bool> fSchemaFrozen;
+  static std::atomic<long long> fWriteTime_ns;
+
+  Schema fSchema;
+  bool fBooked = false;
+  G4int fNtupleId = -1;
+
+  VectorColumn fGapE, fGapAvalancheSize;
+  std::vector<int> fGapNe;
+  std::vector<int> fClusterGap;
+  VectorColumn fClusterX, fClusterY, fClusterZ, fClusterT, fClusterE;
+  std::vector<int> fClusterNe;
+  std::vector<int> fAvalancheGap;
+  VectorColumn fAvalancheX, fAvalancheY, fAvalancheZ, fAvalancheT, fAvalancheNe;
+  VectorColumn fEndpointX, fEndpointY, fEndpointZ, fEndpointT;
+  std::vector<int> fPadId;
+  VectorColumn fPadCharge, fPadToT, fPadLeadingEdge;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef EventSeeds_h
+#define EventSeeds_h
+
+#include <cstdint>
+#include <map>
+#include "G4Threading.hh"
+
+// Sementes por evento (/rpc/random/... e /rpc/replayEvent).
+//
+// No início de cada run o master fixa a semente do run: Mix(semente, run)
+// com /rpc/random/seed, ou, sem ela (0, padrão), um valor tirado do gerador
+// do master, que continua seguindo /random/setSeeds. Cada evento re-semeia o
+// gerador do Geant4 da thread a partir de Mix(semente do run, índice do
+// evento), com índice = /rpc/random/eventOffset + id do evento.
+//
+// O gerador do Garfield++ (Garfield::randomEngine) é um só no processo e não
+// pode ser da thread. Ele é usado só sob GarfieldMutex() e, ao pegar a trava,
+// cada track do gás o re-semeia com SeedGarfieldTrack(): a semente sai da
+// semente do evento (guardada por thread) e do número do track no evento.
+// Como a ordem dos tracks de um evento só depende do gerador do Geant4, o
+// evento não depende da thread que o processa, dos outros workers nem dos
+// eventos anteriores, então:
+//   - o mesmo run dá o mesmo resultado com qualquer número de threads;
+//   - jobs com a mesma semente e offsets disjuntos dividem uma campanha sem
+//     repetir eventos;
+//   - /rpc/replayEvent <run> <índice> refaz um evento isolado.
+//
+// A AvalancheTable (modo parametrizado) é amostrada com o gerador do
+// Garfield++ semeado pela semente do run em que é montada; para refazer um
+// evento em outro processo exatamente, leia a mesma tabela com
+// /garfield/avalanche/tableFile.
+class EventSeeds {
+ public:
+  // splitmix64: semente derivada de (semente, índice)
+  static std::uint64_t Mix(std::uint64_t seed, std::uint64_t index) {
+    std::uint64_t z = seed + 0x9e3779b97f4a7c15ULL * (index + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  // Configuração (master, entre runs); 0 = semente do run tirada do gerador
+  static void SetSeed(std::uint64_t seed) { fSeed = seed; }
+  static std::uint64_t GetSeed() { return fSeed; }
+  static void SetEventOffset(long offset) { fEventOffset = offset; }
+  static long GetEventOffset() { return fEventOffset; }
+
+  // Próximo run refaz só o evento (run, índice); false se a semente desse run
+  // não é conhecida (outro processo sem /rpc/random/seed).
+  static bool SetReplay(int run, long event);
+  static void ClearReplay() { fReplay = false; }
+  static bool IsReplaying() { return fReplay; }
+
+  // Master, no BeginOfRunAction, antes de inicializar a física
+  static void BeginRun(int runId);
+  // Run e semente do run corrente (no replay, os do evento refeito)
+  static int GetRun() { return fRun; }
+  static std::uint64_t GetRunSeed() { return fRunSeed; }
+
+  // Índice global do evento: offset + id, ou o índice do replay
+  static long GetEventIndex(int eventId) { return fReplay ? fReplayEvent : fEventOffset + eventId; }
+  // Re-semeia o gerador do Geant4 (da thread) e guarda a semente do evento
+  static void SeedEvent(long eventIndex);
+  // Re-semeia o gerador do Garfield++ para o próximo track do evento da
+  // thread; chamado com GarfieldMutex() travado
+  static void SeedGarfieldTrack();
+  // Só o gerador do Garfield++, antes de amostrar a AvalancheTable
+  static void SeedTableSampling();
+
+  // Trava de todo uso do gerador global do Garfield++ (Garfield::randomEngine),
+  // que não é seguro entre threads
+  static G4Mutex& GarfieldMutex();
+
+ private:
+  static void SeedGarfield(std::uint64_t seed);
+
+  static std::uint64_t fSeed;
+  static long fEventOffset;
+  static int fRun;
+  static std::uint64_t fRunSeed;
+  static std::map<int, std::uint64_t> fRunSeeds;
+  static bool fReplay;
+  static int fReplayRun;
+  static long fReplayEvent;
+  // Do evento em curso na thread
+  static G4ThreadLocal std::uint64_t fEventSeed;
+  static G4ThreadLocal std::uint64_t fGarfieldTracks;
+};
+
+#endif
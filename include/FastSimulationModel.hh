@@ -21,6 +21,9 @@ class FastSimulationModel : public G4VFastSimulationModel {
 
  private:
   GarfieldPhysics* fGarfieldPhysics;
+  const ApplicabilityTable* fApplicability = nullptr;
+  const G4ParticleDefinition* fElectron = nullptr;
+  const G4ParticleDefinition* fGamma = nullptr;
 };
 
 #endif
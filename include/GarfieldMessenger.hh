@@ -0,0 +1,54 @@
+#ifndef GarfieldMessenger_h
+#define GarfieldMessenger_h
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithABool;
+
+class GarfieldMessenger : public G4UImessenger {
+ public:
+  GarfieldMessenger();
+  ~GarfieldMessenger() override;
+
+  void SetNewValue(G4UIcommand*, G4String) override;
+  G4String GetCurrentValue(G4UIcommand*) override;
+
+ private:
+  G4UIdirectory* fGarfieldDir = nullptr;
+  G4UIcmdWithABool* fEnableCmd = nullptr;
+  G4UIcmdWithAString* fIonizationModelCmd = nullptr;
+  G4UIcmdWithABool* fSecondariesCmd = nullptr;
+  G4UIdirectory* fSecondariesDir = nullptr;
+  G4UIcmdWithADoubleAndUnit* fElectronThresholdCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fPhotonThresholdCmd = nullptr;
+  G4UIdirectory* fAvalancheDir = nullptr;
+  G4UIcmdWithAString* fAvalancheModeCmd = nullptr;
+  G4UIcmdWithAnInteger* fTableBinsCmd = nullptr;
+  G4UIcmdWithAnInteger* fTableSamplesCmd = nullptr;
+  G4UIcmdWithAString* fTableFileCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fDriftStepCmd = nullptr;
+  G4UIcmdWithAString* fSaturationCmd = nullptr;
+  G4UIcmdWithAnInteger* fSizeLimitCmd = nullptr;
+  G4UIcmdWithADouble* fEventLimitCmd = nullptr;
+  G4UIcmdWithAnInteger* fSampleStrideCmd = nullptr;
+  G4UIcmdWithADouble* fSaturationSizeCmd = nullptr;
+  G4UIdirectory* fGasDir = nullptr;
+  G4UIcmdWithAString* fGasFileCmd = nullptr;
+  G4UIcmdWithAString* fGasCompositionCmd = nullptr;
+  G4UIcmdWithABool* fGasCacheCmd = nullptr;
+  G4UIdirectory* fFieldDir = nullptr;
+  G4UIcmdWithAString* fFieldModelCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fFieldMapPitchCmd = nullptr;
+  G4UIcmdWithAnInteger* fFieldMapPlanesCmd = nullptr;
+  G4UIdirectory* fVisDir = nullptr;
+  G4UIcmdWithAnInteger* fMaxDriftLinesCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fDriftLineCellCmd = nullptr;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef GasTableCache_h
+#define GasTableCache_h
+
+#include <string>
+
+namespace Garfield {
+class MediumGas;
+}
+
+// Cache binário e versionado das tabelas de transporte de um arquivo .gas do
+// Magboltz. A chave é a composição, temperatura e pressão da tabela, mais o
+// tamanho e a data do .gas de origem: se o .gas mudar, o cache fica obsoleto
+// e o chamador deve voltar ao LoadGasFile em ASCII. O arquivo é lido por mmap
+// e copiado para as tabelas do meio; cada processo tem a sua cópia, o ganho é
+// não interpretar o texto do .gas.
+//
+// Só as tabelas vão para o cache: os índices de limiar do Townsend e do
+// attachment e os métodos de interpolação/extrapolação que o LoadGasFile lê do
+// .gas não têm acesso público no Garfield++ e ficam os padrões do meio. Por
+// isso todo cache gravado passa por Check() contra o meio lido do .gas, e um
+// cache que não reproduz o ASCII é apagado.
+//
+// Não depende do Geant4, para poder ser usado também pela ferramenta
+// rpc_gascache.
+class GasTableCache {
+ public:
+  // Lê o cache para dentro de gas. Retorna false (sem alterar as tabelas) se o
+  // arquivo não existe, tem outra versão ou não corresponde a sourceFile ou à
+  // composição, temperatura e pressão já definidas em gas.
+  static bool Load(Garfield::MediumGas& gas, const std::string& cacheFile,
+                   const std::string& sourceFile, std::string* reason = nullptr);
+
+  // Grava as tabelas já carregadas em gas.
+  static bool Write(Garfield::MediumGas& gas, const std::string& cacheFile,
+                    const std::string& sourceFile);
+
+  // Lê cacheFile num meio novo (composição, temperatura e pressão de source) e
+  // compara com source a velocidade de deriva, o Townsend e o attachment: em
+  // cada ponto da grade de E, nos pontos médios, fora da grade e em pontos
+  // densos em volta dos limiares do Townsend e do attachment. Retorna false e
+  // descreve as diferenças em report se algum ponto não bate.
+  static bool Check(Garfield::MediumGas& source, const std::string& cacheFile,
+                    const std::string& sourceFile, std::string* report = nullptr);
+
+  static std::string DefaultCacheName(const std::string& sourceFile) {
+    return sourceFile + ".bin";
+  }
+
+  // Composição normalizada, p.ex. "C2H2F4:0.9,SF6:0.05,iC4H10:0.05".
+  static std::string CompositionKey(Garfield::MediumGas& gas);
+
+  // Mesmos gases e frações iguais a menos de tolerance (frações normalizadas)
+  static bool SameComposition(const std::string& key1, const std::string& key2,
+                              double tolerance = 1.e-3);
+};
+
+#endif
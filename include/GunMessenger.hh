@@ -0,0 +1,32 @@
+#ifndef GunMessenger_h
+#define GunMessenger_h
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+
+// Comandos /rpc/gun/... do gerador de primários (PrimaryGeneratorAction).
+class GunMessenger : public G4UImessenger {
+ public:
+  GunMessenger();
+  ~GunMessenger() override;
+
+  void SetNewValue(G4UIcommand*, G4String) override;
+  G4String GetCurrentValue(G4UIcommand*) override;
+
+ private:
+  G4UIdirectory* fGunDir = nullptr;
+  G4UIcmdWithAString* fModeCmd = nullptr;
+  G4UIcmdWithAString* fParticleCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fEnergyCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fMaxZenithCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fMinMomentumCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fMaxMomentumCmd = nullptr;
+  G4UIcmdWithADouble* fChargeRatioCmd = nullptr;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef H3FillBuffer_h
+#define H3FillBuffer_h
+
+#include <cstddef>
+#include <vector>
+
+// Coordenadas exatas dos preenchimentos de um H3 do G4AnalysisManager,
+// guardadas durante o evento e repassadas em Flush(), uma chamada por ponto
+// e na ordem de chegada. O H3 fica igual ao preenchido elétron a elétron:
+// mesmas entradas e mesmos Sxw/Sx2w (média e RMS não vão para o centro do
+// bin); o ganho é tirar o FillH3 do laço do transporte.
+class H3FillBuffer {
+ public:
+  void Book() { fBooked = true; }
+  bool IsBooked() const { return fBooked; }
+
+  void Reserve(std::size_t n) { fPoints.reserve(3 * n); }
+
+  void Fill(double x, double y, double z) {
+    fPoints.push_back(x);
+    fPoints.push_back(y);
+    fPoints.push_back(z);
+  }
+
+  // Guarda (scale*a[i], scale*b[i], scale*c[i]) dos índices com mask[i].
+  void FillBatch(const double* a, const double* b, const double* c,
+                 const unsigned char* mask, std::size_t n, double scale) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (mask[i]) Fill(scale * a[i], scale * b[i], scale * c[i]);
+    }
+  }
+
+  // Chama fill(x, y, z, 1.) para cada ponto do evento e o esvazia.
+  template <class FillFunction>
+  void Flush(FillFunction fill) {
+    for (std::size_t i = 0; i < fPoints.size(); i += 3) {
+      fill(fPoints[i], fPoints[i + 1], fPoints[i + 2], 1.);
+    }
+    fPoints.clear();
+  }
+
+  std::size_t GetNumberOfPoints() const { return fPoints.size() / 3; }
+
+ private:
+  std::vector<double> fPoints;  // x, y, z intercalados
+  bool fBooked = false;
+};
+
+#endif
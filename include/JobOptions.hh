@@ -0,0 +1,54 @@
+#ifndef JobOptions_h
+#define JobOptions_h
+
+#include <string>
+
+// Opções de linha de comando para dividir uma campanha em jobs:
+//
+//   RPC [--job i] [--jobs n] [--seed s] [--seed-offset k] [--output prefixo] [macro]
+//
+// --job/--jobs: índice (0..n-1) e número de jobs; vão para o RunInfo e, com
+//   --job, o arquivo de saída ganha o sufixo _job<i>.
+// --seed: /rpc/random/seed (semente da campanha, a mesma em todos os jobs).
+// --seed-offset: /rpc/random/eventOffset; sem ela, o job i começa no índice
+//   i * kJobEventStride, então jobs de até kJobEventStride eventos por run
+//   não repetem eventos.
+// --output: prefixo do arquivo de saída, colado ao nome de
+//   /analysis/setFileName (p.ex. "/scratch/c1/" ou "c1_").
+//
+// Os valores de semente são aplicados antes da macro, que ainda pode
+// trocá-los; o nome de saída é montado a cada run no RunAction, a partir do
+// nome que a macro escolheu.
+class JobOptions {
+ public:
+  static constexpr long kJobEventStride = 1000000;
+
+  // Lê argv; macro fica vazia sem macro (sessão interativa). false se as
+  // opções são inválidas (a mensagem já foi escrita).
+  static bool Parse(int argc, char** argv, std::string& macro);
+  // Aplica as opções de semente (chamado por RPC.cc antes da macro)
+  static void Apply();
+
+  static int GetJob() { return fJob; }
+  static int GetJobs() { return fJobs; }
+  static const std::string& GetOutputPrefix() { return fOutputPrefix; }
+
+  // Nome do arquivo deste job: prefixo + nome + _job<i>, com o sufixo antes
+  // da extensão. StripOutputName desfaz; as duas são idempotentes juntas.
+  static std::string OutputName(const std::string& name);
+  static std::string StripOutputName(const std::string& name);
+
+ private:
+  static std::string JobSuffix();
+
+  static int fJob;
+  static int fJobs;
+  static bool fHasJob;
+  static bool fHasSeed;
+  static unsigned long long fSeed;
+  static long fSeedOffset;
+  static bool fHasSeedOffset;
+  static std::string fOutputPrefix;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef Log_h
+#define Log_h
+
+#include <atomic>
+#include <string>
+#include "globals.hh"
+
+// Nível de log em tempo de execução (/rpc/log/level). Mensagens com nível
+// acima do corrente não são formatadas nem enviadas ao G4cout.
+class Log {
+ public:
+  enum Level { kError = 0, kWarning, kInfo, kDebug, kTrace };
+
+  static bool IsEnabled(Level level) {
+    return level <= fLevel.load(std::memory_order_relaxed);
+  }
+  static void SetLevel(Level level) {
+    fLevel.store(level, std::memory_order_relaxed);
+  }
+  static Level GetLevel() {
+    return static_cast<Level>(fLevel.load(std::memory_order_relaxed));
+  }
+  static bool LevelFromString(const std::string& name, Level& level);
+  static const char* LevelName(Level level);
+
+ private:
+  static std::atomic<int> fLevel;
+};
+
+// Nível máximo compilado no executável. Em Release o CMake define 3 (debug),
+// de modo que as mensagens de trace ([LOG] por track/evento) somem do binário.
+#ifndef RPC_LOG_COMPILE_LEVEL
+#define RPC_LOG_COMPILE_LEVEL 4
+#endif
+
+#define RPC_LOG(level, msg)                         \
+  do {                                              \
+    if (Log::IsEnabled(level)) {                    \
+      G4cout << msg << G4endl;                      \
+    }                                               \
+  } while (0)
+
+#define RPC_LOG_ERROR(msg) RPC_LOG(Log::kError, msg)
+#define RPC_LOG_WARNING(msg) RPC_LOG(Log::kWarning, msg)
+#define RPC_LOG_INFO(msg) RPC_LOG(Log::kInfo, msg)
+
+#if RPC_LOG_COMPILE_LEVEL >= 3
+#define RPC_LOG_DEBUG(msg) RPC_LOG(Log::kDebug, msg)
+#else
+#define RPC_LOG_DEBUG(msg) do {} while (0)
+#endif
+
+#if RPC_LOG_COMPILE_LEVEL >= 4
+#define RPC_LOG_TRACE(msg) RPC_LOG(Log::kTrace, msg)
+#else
+#define RPC_LOG_TRACE(msg) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef LogMessenger_h
+#define LogMessenger_h
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithAString;
+
+class LogMessenger : public G4UImessenger {
+ public:
+  LogMessenger();
+  ~LogMessenger() override;
+
+  void SetNewValue(G4UIcommand*, G4String) override;
+  G4String GetCurrentValue(G4UIcommand*) override;
+
+ private:
+  G4UIdirectory* fRpcDir = nullptr;
+  G4UIdirectory* fLogDir = nullptr;
+  G4UIcmdWithAString* fLevelCmd = nullptr;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef OutputMessenger_h
+#define OutputMessenger_h
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+
+// Comandos /rpc/output/... do esquema do ntuple (EventOutput).
+class OutputMessenger : public G4UImessenger {
+ public:
+  OutputMessenger();
+  ~OutputMessenger() override;
+
+  void SetNewValue(G4UIcommand*, G4String) override;
+  G4String GetCurrentValue(G4UIcommand*) override;
+
+ private:
+  G4UIdirectory* fOutputDir = nullptr;
+  G4UIcmdWithABool* fLayersCmd = nullptr;
+  G4UIcmdWithABool* fGapsCmd = nullptr;
+  G4UIcmdWithABool* fClustersCmd = nullptr;
+  G4UIcmdWithABool* fAvalanchesCmd = nullptr;
+  G4UIcmdWithABool* fEndpointsCmd = nullptr;
+  G4UIcmdWithABool* fPadsCmd = nullptr;
+  G4UIcmdWithAString* fPrecisionCmd = nullptr;
+  G4UIcmdWithAnInteger* fCompressionCmd = nullptr;
+  G4UIcmdWithABool* fMergeCmd = nullptr;
+};
+
+#endif
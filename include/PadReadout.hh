@@ -0,0 +1,96 @@
+#ifndef PadReadout_h
+#define PadReadout_h
+
+#include <vector>
+
+class WeightingPotentialTable;
+
+struct PadHit {
+  int id;                    // câmara * nPadsX * nPadsZ + copy number do physPad (ix * nPadsZ + iz)
+  double charge;             // carga induzida [fC]
+  double timeOverThreshold;  // [ns]
+  double leadingEdge;        // [ns]
+};
+
+// Leitura dos pads por indução (teorema de Ramo). Cada segmento de drift
+// contribui, em cada pad próximo, com -n * dphi, onde phi é o potencial de
+// ponderação tabelado (WeightingPotentialTable) e n o número de elétrons no
+// segmento. A corrente é amostrada em bins de tempo fixos a partir do tempo
+// mais cedo do evento: um segmento anterior à origem atual desloca os bins
+// já preenchidos. Só os pads vizinhos ao ponto do segmento são avaliados; a
+// lista dos pads tocados é zerada em Clear().
+//
+// Cada câmara tem a sua matriz de pads, escolhida por SelectGap() antes dos
+// segmentos de um gap. Todos os gaps de uma câmara induzem nos mesmos pads,
+// cada um com a tabela da sua distância até os pads.
+//
+// A configuração (limiar, binagem) é compartilhada e muda só entre runs; o
+// acúmulo é de cada thread.
+class PadReadout {
+ public:
+  static void SetEnabled(bool flag) { fEnabled = flag; }
+  static bool IsEnabled() { return fEnabled; }
+  // Limiar sobre a corrente induzida [fC/ns = uA]
+  static void SetThreshold(double threshold) { fThreshold = threshold; }
+  static double GetThreshold() { return fThreshold; }
+  static void SetTimeBinning(double binWidth, int nBins) {
+    fBinWidth = binWidth;
+    fNumberOfBins = nBins;
+  }
+  static double GetTimeBinWidth() { return fBinWidth; }
+  static int GetNumberOfTimeBins() { return fNumberOfBins; }
+
+  // Lê a matriz de pads do DetectorParameters; as tabelas (uma por gap da
+  // câmara) são do chamador.
+  void Configure(const std::vector<WeightingPotentialTable>* tables);
+  void Clear();
+
+  // Câmara e gap dentro da câmara dos próximos segmentos
+  void SelectGap(int chamber, int gapInChamber);
+
+  // Segmento de (x1, y1, z1, t1) a (x2, y2, z2, t2) [cm, ns]. O número de
+  // elétrons cresce exponencialmente de 1 até gain ao longo do segmento
+  // (gain = 1 para um elétron que só deriva).
+  void AddSegment(double x1, double y1, double z1, double t1,
+                  double x2, double y2, double z2, double t2, double gain = 1.);
+
+  // Aplica o limiar e preenche GetHits().
+  void Finish();
+
+  const std::vector<PadHit>& GetHits() const { return fHits; }
+
+ private:
+  struct PadSignal {
+    int id;
+    double charge;
+    std::vector<double> current;
+  };
+
+  PadSignal& Touch(int id);
+  // Leva a origem dos bins para antes de t, deslocando as correntes
+  void MoveOrigin(double t);
+
+  static bool fEnabled;
+  static double fThreshold;
+  static double fBinWidth;
+  static int fNumberOfBins;
+
+  const std::vector<WeightingPotentialTable>* fTables = nullptr;
+  const WeightingPotentialTable* fTable = nullptr;
+  int fNX = 0;
+  int fNZ = 0;
+  double fPitchX = 0.;
+  double fPitchZ = 0.;
+  double fFirstX = 0.;
+  double fFirstZ = 0.;
+  int fChamberOffset = 0;
+
+  double fT0 = 0.;
+  bool fHasT0 = false;
+  std::vector<int> fSlot;           // pad -> índice em fSignals, -1 se não tocado
+  std::vector<PadSignal> fSignals;  // pads tocados no evento; capacidade reaproveitada
+  std::size_t fNSignals = 0;
+  std::vector<PadHit> fHits;
+};
+
+#endif
@@ -1,14 +1,30 @@
 #ifndef Physics_h
 #define Physics_h
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <vector>
+#include "Garfield/AvalancheMC.hh"
 #include "Garfield/ComponentAnalyticField.hh"
 #include "Garfield/MediumMagboltz.hh"
 #include "Garfield/Sensor.hh"
 #include "Garfield/TrackHeed.hh"
 #include "G4ThreeVector.hh" 
+#include "ApplicabilityTable.hh"
+#include "H3FillBuffer.hh"
+#include "DriftLineBuffer.hh"
+#include "ElectronBatch.hh"
+#include "PadReadout.hh"
+#include "globals.hh"
+
+class AvalancheTable;
+class ComponentGapFieldMap;
+class ComponentUniformGap;
+class G4ParticleDefinition;
+class WeightingPotentialTable;
+class EventOutput;
 
 using EnergyRange_MeV = std::pair<double, double>;
 using MapParticlesEnergy = std::map<std::string, EnergyRange_MeV>;
@@ -44,74 +60,294 @@ class GarfieldParticle {
   double fEkin_MeV, fTime, fx_mm, fy_mm, fz_mm, fdx, fdy, fdz;
 };
 
+// Uma instância por thread (worker) do Geant4: Sensor, TrackHeed e AvalancheMC
+// são privados de cada thread. O meio (MediumMagboltz), o campo
+// (um Garfield::Component, ver FieldModel) e a tabela de partículas são compartilhados e
+// somente leitura depois de InitializeSharedPhysics(). Gap, tensão e área do
+// Sensor vêm do DetectorParameters e são refeitos quando a versão muda.
+//
+// O Garfield++ tem um único gerador no processo (Garfield::randomEngine, um
+// TRandom3 sem proteção entre threads), usado pelo TrackHeed e pelo
+// AvalancheMC, e o TrackHeed lê e zera os flags IsChanged() do meio
+// compartilhado. Por isso a parte Garfield++ do DoIt (clusters do Heed e, no
+// modo full, o AvalancheMC) roda sob a trava EventSeeds::GarfieldMutex(): ela
+// não ganha nada com mais threads, só o Geant4 e o modo parametrizado (que
+// sorteia com o gerador do Geant4 da thread) rodam em paralelo.
+//
+// O contexto de transporte da thread (AvalancheMC e buffers de elétrons,
+// segmentos de drift e secundários) vive entre tracks e eventos: cada DoIt
+// só zera os contadores, e a capacidade alcançada nos primeiros eventos é
+// reaproveitada (ver AllocationCounter).
+//
+// Com vários gaps (DetectorParameters: gaps por câmara x câmaras) todos são
+// iguais no sistema local do gás, então o meio, o campo e o Sensor da thread
+// servem a todos: o custo de inicialização e a memória das tabelas não
+// crescem com o número de gaps. O que é de cada gap é o resultado do evento
+// (GapResult) e a câmara dos pads; o gap do track vem do FastSimulationModel,
+// pelo copy number do volume de gás e da câmara.
 class GarfieldPhysics {
  public:
+  // Full: AvalancheMC para cada elétron primário.
+  // Parameterized: consulta à AvalancheTable montada na inicialização.
+  enum class AvalancheMode { Full, Parameterized };
+  // Off: avalanches sem limite (tamanho do AvalancheMC/tabela tal como sai).
+  // Truncate: cada avalanche para em GetAvalancheSizeLimit() elétrons e,
+  // passado GetEventSizeLimit() no evento, só 1 a cada GetSampleStride()
+  // elétrons primários restantes é transportado, com peso igual ao passo.
+  // SpaceCharge: os mesmos limites, e o tamanho de cada avalanche passa por
+  // n_sat (1 - exp(-n / n_sat)), a saturação por carga espacial que o
+  // AvalancheMC não modela.
+  enum class SaturationMode { Off, Truncate, SpaceCharge };
+  // Componente do campo no gap, consultado pelo Sensor a cada passo do drift.
+  // Analytic: ComponentAnalyticField com os dois planos (referência).
+  // Uniform: ComponentUniformGap, o campo constante sem a célula genérica.
+  // Map: ComponentGapFieldMap amostrado do ComponentAnalyticField, para
+  // variantes não uniformes do gap.
+  enum class FieldModel { Analytic, Uniform, Map };
+  // Somas do evento em um gap
+  struct GapResult {
+    double energy = 0.;         // [eV]
+    double avalancheSize = 0.;
+    int electrons = 0;          // elétrons primários aceitos
+  };
+
   static GarfieldPhysics* GetInstance();
   static void Dispose();
-  double GetEnergyDeposit_MeV();
+  static void InitializeSharedPhysics();
   void InitializePhysics();
 
-  void DoIt(std::string particleName, double ekin_MeV, double time, double x_cm,
-            double y_cm, double z_cm, double dx, double dy, double dz);
-
-  void AddParticleName(const std::string particleName, double ekin_min_MeV,
-                       double ekin_max_MeV, std::string program);
-  bool FindParticleName(const std::string name,
-                        std::string program = "garfield");
-  bool FindParticleNameEnergy(std::string name, double ekin_MeV,
-                              std::string program = "garfield");
-  double GetMinEnergyMeVParticle(std::string name,
-                                 std::string program = "garfield");
-  double GetMaxEnergyMeVParticle(std::string name,
-                                 std::string program = "garfield");
+  // Posição e direção no sistema local do gap; gap é o índice global
+  // (DetectorParameters::GetGapIndex)
+  void DoIt(const std::string& particleName, double ekin_MeV, double time, double x_cm,
+            double y_cm, double z_cm, double dx, double dy, double dz, int gap = 0);
+
+  void AddParticleName(const std::string& particleName, double ekin_min_MeV,
+                       double ekin_max_MeV, const std::string& program);
+  bool FindParticleName(const std::string& name,
+                        const std::string& program = "garfield");
+  bool FindParticleNameEnergy(const std::string& name, double ekin_MeV,
+                              const std::string& program = "garfield");
+  double GetMinEnergyMeVParticle(const std::string& name,
+                                 const std::string& program = "garfield");
+  double GetMaxEnergyMeVParticle(const std::string& name,
+                                 const std::string& program = "garfield");
+  // Congela os mapas por nome em tabelas indexadas pela partícula. Precisa
+  // da tabela de partículas pronta (ConstructProcess); depois disso
+  // AddParticleName não tem mais efeito.
+  static void FreezeParticleTables();
+  static const ApplicabilityTable& GetGarfieldTable() { return fGarfieldTable; }
+  static const ApplicabilityTable& GetGeant4Table() { return fGeant4Table; }
+  static int GetParticleIndex(const G4ParticleDefinition* particle);
+  // Desligado, o modelo rápido não dispara e o gás é tratado só pelo Geant4.
+  static void SetEnabled(bool flag) { fEnabled = flag; }
+  static bool IsEnabled() { return fEnabled; }
+  static void SetAvalancheMode(AvalancheMode mode) { fAvalancheMode = mode; }
+  static AvalancheMode GetAvalancheMode() { return fAvalancheMode; }
+  static void SetAvalancheTableBinning(int nBins, int nSamples);
+  static void SetAvalancheTableFile(const std::string& fileName);
+  static int GetAvalancheTableBins() { return fAvalancheTableBins; }
+  static int GetAvalancheTableSamples() { return fAvalancheTableSamples; }
+  static const std::string& GetAvalancheTableFile() { return fAvalancheTableFile; }
+  static void SetSaturationMode(SaturationMode mode) { fSaturationMode = mode; }
+  static SaturationMode GetSaturationMode() { return fSaturationMode; }
+  static void SetAvalancheSizeLimit(unsigned int size) { fAvalancheSizeLimit = size; }
+  static unsigned int GetAvalancheSizeLimit() { return fAvalancheSizeLimit; }
+  static void SetEventSizeLimit(double size) { fEventSizeLimit = size; }
+  static double GetEventSizeLimit() { return fEventSizeLimit; }
+  static void SetSampleStride(int stride) { fSampleStride = stride; }
+  static int GetSampleStride() { return fSampleStride; }
+  static void SetSaturationSize(double size) { fSaturationSize = size; }
+  static double GetSaturationSize() { return fSaturationSize; }
+  // Eventos truncados (alguma avalanche no limite ou primários amostrados),
+  // somados entre as threads; zerado pelo master no fim do run.
+  static long GetTruncatedEvents() { return fTruncatedEvents; }
+  static void ResetTruncatedEvents() { fTruncatedEvents = 0; }
+  static void SetUseGasCache(bool flag) { fUseGasCache = flag; }
+  static bool GetUseGasCache() { return fUseGasCache; }
+  // Meio gasoso: tabela .gas e a composição que ela descreve, p.ex.
+  // "ic4h10 5 sf6 5 c2h2f4 90" (até 6 componentes). Trocar um dos dois refaz
+  // só o meio no próximo run; o campo e os Sensors continuam os mesmos.
+  static void SetGasFile(const std::string& fileName);
+  static const std::string& GetGasFile() { return fGasFile; }
+  static bool SetGasComposition(const std::string& composition);
+  static std::string GetGasComposition();
+  // Trocar o modelo ou a grade do mapa refaz o campo e os Sensors no
+  // próximo run, como uma mudança de tensão.
+  static void SetFieldModel(FieldModel model);
+  static FieldModel GetFieldModel() { return fFieldModel; }
+  // Espaçamento da grade em x e z [cm] e número de planos de nós em y
+  static void SetFieldMapBinning(double pitch, int nPlanes);
+  static double GetFieldMapPitch() { return fFieldMapPitch; }
+  static int GetFieldMapPlanes() { return fFieldMapPlanes; }
+  // Passo do AvalancheMC [cm]; também é a chave da AvalancheTable.
+  static void SetDriftStep(double step);
+  static double GetDriftStep() { return fDriftStep; }
   void SetIonizationModel(std::string model, bool useDefaults = true);
   std::string GetIonizationModel();
   const std::vector<GarfieldParticle>& GetSecondaryParticles() const {
     return fSecondaryParticles;
   }
-  void EnableCreateSecondariesInGeant4(bool flag) {
+  static void EnableCreateSecondariesInGeant4(bool flag) {
     createSecondariesInGeant4 = flag;
   }
-  bool GetCreateSecondariesInGeant4() const { 
+  static bool GetCreateSecondariesInGeant4() {
     return createSecondariesInGeant4; 
   }
-  double GetEnergyDeposit_MeV() const { return fEnergyDeposit / 1000000; }
-  double GetAvalancheSize() const { return fAvalancheSize; }
-  double GetGain() const { return fGain; }
+  // Com os secundários ligados, delta-elétrons e fótons de fluorescência do
+  // Heed acima destes limiares [eV] voltam ao Geant4; os demais são
+  // transportados no Garfield++ e depositam a energia no gás.
+  static void SetSecondaryThresholds(double electron_eV, double photon_eV) {
+    fSecondaryElectronThreshold = electron_eV;
+    fSecondaryPhotonThreshold = photon_eV;
+  }
+  static double GetSecondaryElectronThreshold() { return fSecondaryElectronThreshold; }
+  static double GetSecondaryPhotonThreshold() { return fSecondaryPhotonThreshold; }
+  // Energia levada pelos secundários do último DoIt
+  double GetSecondaryEnergy_MeV() const { return fSecondaryEnergy / 1000000; }
+  // Fóton primário absorvido no gás (o track termina no DoIt)
+  bool IsPrimaryAbsorbed() const { return fPrimaryAbsorbed; }
+  // Do último DoIt (um track): os deltas acima do limiar voltam ao gás como
+  // tracks novos, então um evento pode ter vários
+  double GetTrackEnergyDeposit_MeV() const { return fEnergyDeposit / 1000000; }
+  double GetTrackAvalancheSize() const { return fAvalancheSize; }
+  double GetTrackGain() const { return fGain; }
+  // Do evento: somas sobre os gaps (GetGapResults()), zeradas só em Clear()
+  double GetEventEnergyDeposit_MeV() const;
+  double GetEventAvalancheSize() const { return fEventAvalancheSize; }
+  double GetEventGain() const;
+  bool IsEventTruncated() const { return fEventTruncated; }
   void Clear() {
     fEnergyDeposit = 0;
     fAvalancheSize = 0;
+    fEventAvalancheSize = 0;
+    fEventTruncated = false;
     fGain = 0;
     nsum = 0;
+    fPadReadout.Clear();
+    fDriftLines.Clear();
+    std::fill(fGapResults.begin(), fGapResults.end(), GapResult());
   }
-  const std::vector<std::pair<G4ThreeVector, G4ThreeVector>>& GetDriftLines() const { return fDriftLines; }
-
-  static constexpr double kGap   = 0.2;   // [cm]
-  static constexpr double kHalfX = 5.0;   // [cm]
-  static constexpr double kHalfY = 5.0;   // [cm]
+  // Um por gap, somados sobre os tracks do evento
+  const std::vector<GapResult>& GetGapResults() const { return fGapResults; }
+  // Chamado pelo EventAction no fim do evento
+  void CountTruncatedEvent() {
+    if (fEventTruncated) ++fTruncatedEvents;
+  }
+  // Linhas de drift para a visualização: só são guardadas com o vis ativo
+  // (o EventAction liga a coleta no início de cada evento), no máximo
+  // maxLines por evento e uma por célula de lado cellSize (ver DriftLineBuffer).
+  static void SetDriftLineLimits(int maxLines, double cellSize) {
+    fMaxDriftLines = maxLines;
+    fDriftLineCell = cellSize;
+  }
+  static int GetMaxDriftLines() { return fMaxDriftLines; }
+  static double GetDriftLineCell() { return fDriftLineCell; }
+  void SetCollectDriftLines(bool flag) { fCollectDriftLines = flag; }
+  const DriftLineBuffer& GetDriftLines() const { return fDriftLines; }
+  // Repassa ao H3 do G4AnalysisManager as contagens acumuladas no evento.
+  void FlushHistograms();
+  PadReadout& GetPadReadout() { return fPadReadout; }
+  // Destino dos clusters/avalanches/pontos finais do evento (do RunAction da thread)
+  void SetEventOutput(EventOutput* output) { fEventOutput = output; }
 
  private:
   GarfieldPhysics() = default;
   ~GarfieldPhysics();
 
-  std::string fIonizationModel = "Heed";
+  static void BuildMedium();
+  static void LoadGasTable();
+  static void BuildField();
+  static void BuildWeightingTable();
+  static void BuildAvalancheTable();
+  std::size_t AddClusterElectrons(const Garfield::TrackHeed::Cluster& cluster);
+  void TransportElectron(double x, double y, double z, double t, double weight);
+  double AddAvalancheSize(double x, double y, double z, double t, double ne, double weight);
+  void AddEndpoint(double x1, double y1, double z1, double t1,
+                   double x2, double y2, double z2, double t2, double weight);
+  double SaturatedSize(double size);
+  void ConfigureTransport();
+  void BookTrackPositionHistogram();
+  void ReserveBuffers();
+
+  static G4ThreadLocal GarfieldPhysics* fGarfieldPhysics;
 
-  static GarfieldPhysics* fGarfieldPhysics;
+  // Estado compartilhado entre as threads
+  static std::string fIonizationModel;
+  static MapParticlesEnergy fMapParticlesEnergyGeant4;
+  static MapParticlesEnergy fMapParticlesEnergyGarfield;
+  static ApplicabilityTable fGarfieldTable;
+  static ApplicabilityTable fGeant4Table;
+  static bool fParticleTablesFrozen;
+  static Garfield::MediumMagboltz* fMediumMagboltz;
+  static Garfield::ComponentAnalyticField* fComponentAnalyticField;
+  static ComponentUniformGap* fUniformGap;
+  static ComponentGapFieldMap* fFieldMap;
+  // O componente em uso, um dos três acima
+  static Garfield::Component* fField;
+  static FieldModel fFieldModel;
+  static double fFieldMapPitch;
+  static int fFieldMapPlanes;
+  static bool createSecondariesInGeant4;
+  static double fSecondaryElectronThreshold;
+  static double fSecondaryPhotonThreshold;
+  static bool fEnabled;
+  static AvalancheMode fAvalancheMode;
+  static AvalancheTable* fAvalancheTable;
+  static int fAvalancheTableBins;
+  static int fAvalancheTableSamples;
+  static std::string fAvalancheTableFile;
+  static bool fUseGasCache;
+  static std::string fGasFile;
+  static std::vector<std::pair<std::string, double>> fGasComponents;
+  static int fGasVersion;
+  static int fMediumVersion;
+  static double fDriftStep;
+  static SaturationMode fSaturationMode;
+  static unsigned int fAvalancheSizeLimit;
+  static double fEventSizeLimit;
+  static int fSampleStride;
+  static double fSaturationSize;
+  static std::atomic<long> fTruncatedEvents;
+  static int fFieldVersion;
+  // Versão da geometria em que os componentes do campo foram criados
+  static int fFieldGeometryVersion;
+  // Uma tabela por posição do gap na câmara (distâncias até pads e terra)
+  static std::vector<WeightingPotentialTable> fWeightingTables;
+  static int fWeightingVersion;
+  static int fMaxDriftLines;
+  static double fDriftLineCell;
 
-  MapParticlesEnergy fMapParticlesEnergyGeant4;
-  MapParticlesEnergy fMapParticlesEnergyGarfield;
-  Garfield::MediumMagboltz* fMediumMagboltz = nullptr;
+  // Estado da thread
   Garfield::Sensor* fSensor = nullptr;
   Garfield::TrackHeed* fTrackHeed = nullptr;
-  Garfield::ComponentAnalyticField* fComponentAnalyticField = nullptr;
+  Garfield::AvalancheMC* fAvalancheMC = nullptr;
+  int fSensorVersion = -1;
+  int fSensorMediumVersion = -1;
+  AcceptanceBox fAcceptance{0., 0., 0., 0.};
+  int fGapsPerChamber = 1;
+  // Gap do track em transporte e o centro dele no mundo (linhas de drift)
+  int fGap = 0;
+  G4ThreeVector fGapCenter;
+  std::vector<GapResult> fGapResults;
 
   std::vector<GarfieldParticle> fSecondaryParticles;
-  std::vector<std::pair<G4ThreeVector, G4ThreeVector>> fDriftLines;
+  DriftLineBuffer fDriftLines;
+  bool fCollectDriftLines = false;
+  ElectronBatch fClusterBatch;
+  ElectronBatch fElectronBatch;
+  H3FillBuffer fTrackPosition;
+  PadReadout fPadReadout;
+  EventOutput* fEventOutput = nullptr;
 
-  bool createSecondariesInGeant4 = false;
+  // Do track em curso; zerados no início de cada DoIt
   double fEnergyDeposit = 0.;
+  double fSecondaryEnergy = 0.;
+  bool fPrimaryAbsorbed = false;
   double fAvalancheSize = 0.;
   double fGain = 0.;
   int nsum = 0;
+  // Do evento; zerados só em Clear()
+  double fEventAvalancheSize = 0.;
+  bool fEventTruncated = false;
 };
 #endif
\ No newline at end of file
@@ -3,7 +3,16 @@
 
 #include "G4VModularPhysicsList.hh"
 #include "globals.hh"
+#include <map>
 
+class G4VPhysicsConstructor;
+class PhysicsListMessenger;
+
+// Física da simulação. A configuração padrão ("full") é a de sempre: EM
+// option4 em todo o detector, QGSP_BERT_HP e decaimento radioativo. O preset
+// "fast" troca a EM fora do gás pela option0 (a option4 fica só na
+// RegionGarfield), usa QGSP_BERT sem HP e desliga o decaimento radioativo;
+// cada escolha também pode ser feita em separado por /rpc/physics/...
 class PhysicsList : public G4VModularPhysicsList {
 public:
     PhysicsList();
@@ -12,8 +21,35 @@ public:
     virtual void ConstructParticle();
     virtual void ConstructProcess();
 
+    // Escolha dos construtores; só em PreInit (antes do /run/initialize)
+    void SetPreset(const G4String& preset);
+    void SetEmOption(const G4String& option);
+    void SetHadronic(const G4String& model);
+    void SetRadioactiveDecay(G4bool flag);
+    const G4String& GetEmOption() const { return fEmOption; }
+    const G4String& GetHadronic() const { return fHadronic; }
+    G4bool GetRadioactiveDecay() const { return fRadioactiveDecay != nullptr; }
+
+    // Cortes de produção das regiões RegionGarfield, RegionGlass e
+    // RegionGraphite. Em Idle o corte novo vale a partir do próximo run.
+    void SetRegionCut(const G4String& region, G4double cut);
+    G4double GetRegionCut(const G4String& region) const;
+
 protected:
     void AddParameterisation();
+
+private:
+    void ApplyEmParameters();
+    void ApplyRegionCut(const G4String& region, G4double cut) const;
+
+    G4String fEmOption = "opt4";
+    G4String fHadronic = "hp";
+    G4VPhysicsConstructor* fHadronElastic = nullptr;
+    G4VPhysicsConstructor* fHadronInelastic = nullptr;
+    G4VPhysicsConstructor* fRadioactiveDecay = nullptr;
+    std::map<G4String, G4double> fRegionCuts;
+
+    PhysicsListMessenger* fMessenger = nullptr;
 };
 
-#endif
\ No newline at end of file
+#endif
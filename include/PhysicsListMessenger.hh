@@ -0,0 +1,40 @@
+#ifndef PhysicsListMessenger_h
+#define PhysicsListMessenger_h
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class PhysicsList;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+
+// Comandos /rpc/physics/... da PhysicsList. A escolha dos construtores só vale
+// antes do /run/initialize; os cortes por região também podem ser trocados
+// entre runs.
+class PhysicsListMessenger : public G4UImessenger {
+ public:
+  explicit PhysicsListMessenger(PhysicsList* physicsList);
+  ~PhysicsListMessenger() override;
+
+  void SetNewValue(G4UIcommand*, G4String) override;
+  G4String GetCurrentValue(G4UIcommand*) override;
+
+ private:
+  G4UIcmdWithAString* MakeChoiceCommand(const char* path, const char* guidance, const char* candidates);
+  G4UIcmdWithADoubleAndUnit* MakeCutCommand(const char* path, const char* guidance);
+
+  PhysicsList* fPhysicsList = nullptr;
+
+  G4UIdirectory* fPhysicsDir = nullptr;
+  G4UIcmdWithAString* fPresetCmd = nullptr;
+  G4UIcmdWithAString* fEmCmd = nullptr;
+  G4UIcmdWithAString* fHadronicCmd = nullptr;
+  G4UIcmdWithABool* fRadioactiveDecayCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fGasCutCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fGlassCutCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fGraphiteCutCmd = nullptr;
+};
+
+#endif
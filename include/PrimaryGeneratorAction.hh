@@ -1,22 +1,73 @@
-
 #ifndef PrimaryGeneratorAction_h
 #define PrimaryGeneratorAction_h
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "globals.hh"
+#include "CosmicMuonSpectrum.hh"
 
 class G4ParticleGun;
 class G4Event;
+class G4ParticleDefinition;
 
+// Dois modos:
+//  - kHemisphere: partícula (mu- por padrão) de energia fixa saindo de uma
+//    semiesfera em torno do gap e apontando para o centro dele (modo original);
+//  - kCosmic: múons cósmicos com I ~ cos^2(theta), espectro de Reyna e razão
+//    mu+/mu- fixa. O ponto de cruzamento com o plano médio do gás é uniforme
+//    na área da câmara e o vértice fica logo acima da pilha, então todo evento
+//    atravessa o gap. Cada evento equivale a GetLiveTimePerEvent() de
+//    exposição ao fluxo real.
+//
+// A configuração é compartilhada (GunMessenger, no master) e as threads a
+// leem no início de cada evento.
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
 public: 
+    enum Mode { kHemisphere, kCosmic };
+
     PrimaryGeneratorAction();
     virtual ~PrimaryGeneratorAction();
     virtual void GeneratePrimaries(G4Event* event);
     void SetRandomFlag(G4bool value);
 
+    static void SetMode(Mode mode) { fMode = mode; }
+    static Mode GetMode() { return fMode; }
+    static void SetParticleName(const G4String& name);
+    static const G4String& GetParticleName() { return fParticleName; }
+    static void SetEnergy(G4double energy) { fEnergy = energy; }
+    static G4double GetEnergy() { return fEnergy; }
+    static void SetMaxZenith(G4double angle) { fMaxZenith = angle; }
+    static G4double GetMaxZenith() { return fMaxZenith; }
+    static void SetMomentumRange(G4double pMin, G4double pMax);
+    static G4double GetMinMomentum() { return fMinMomentum; }
+    static G4double GetMaxMomentum() { return fMaxMomentum; }
+    static void SetChargeRatio(G4double ratio) { fChargeRatio = ratio; }
+    static G4double GetChargeRatio() { return fChargeRatio; }
+
+    // Tempo de exposição representado por um evento do modo kCosmic:
+    // 1 / (fluxo pelo plano do gás dentro de theta < maxZenith * área).
+    static G4double GetLiveTimePerEvent();
+
 private:
+    void GenerateHemisphere();
+    void GenerateCosmic();
+
+    static Mode fMode;
+    static G4String fParticleName;
+    static G4int fParticleVersion;
+    static G4double fEnergy;
+    static G4double fMaxZenith;
+    static G4double fMinMomentum;
+    static G4double fMaxMomentum;
+    static G4double fChargeRatio;
+    static G4int fSpectrumVersion;
+
     G4ParticleGun *fParticleGun;
+    G4ParticleDefinition* fMuonMinus = nullptr;
+    G4ParticleDefinition* fMuonPlus = nullptr;
+    G4ParticleDefinition* fParticle = nullptr;  // modo kHemisphere
+    G4int fResolvedParticleVersion = -1;
+    CosmicMuonSpectrum fSpectrum;
+    G4int fBuiltSpectrumVersion = -1;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,67 @@
+#ifndef Profiler_h
+#define Profiler_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Perfil por evento da passagem Geant4 -> Garfield++ (/rpc/profile/...).
+//
+// Cada thread soma, no evento corrente, o tempo das fases medidas com
+// Profiler::Scope e os contadores. Em EndEvent() o evento vira uma amostra;
+// no fim do run as threads entregam as amostras (MergeThread) e o master
+// escreve a tabela e o JSON (Report), com média e percentis por evento.
+//
+// O tempo de transporte do Geant4 na pilha não é medido diretamente: é o
+// tempo do evento menos o das fases do Garfield++ e da análise.
+//
+// Desligado (padrão), Scope e Count só testam uma flag.
+class Profiler {
+ public:
+  enum Phase { kEvent = 0, kHeed, kDrift, kInduction, kAnalysis, kNumberOfPhases };
+  enum Counter { kSteps = 0, kClusters, kElectrons, kAvalancheSize, kDriftLines, kDriftSteps, kNumberOfCounters };
+
+  static void SetEnabled(bool flag) { fEnabled.store(flag, std::memory_order_relaxed); }
+  static bool IsEnabled() { return fEnabled.load(std::memory_order_relaxed); }
+  static void SetFileName(const std::string& fileName);
+  static std::string GetFileName();
+
+  class Scope {
+   public:
+    explicit Scope(Phase phase) : fPhase(phase), fActive(IsEnabled()) {
+      if (fActive) fStart = std::chrono::steady_clock::now();
+    }
+    ~Scope() {
+      if (fActive) AddTime(fPhase, std::chrono::steady_clock::now() - fStart);
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    Phase fPhase;
+    bool fActive;
+    std::chrono::steady_clock::time_point fStart;
+  };
+
+  static void Count(Counter counter, std::uint64_t value = 1) {
+    if (IsEnabled()) AddCount(counter, value);
+  }
+
+  // Chamados pela EventAction da thread; eventIndex é o índice de
+  // /rpc/replayEvent, para listar os eventos mais lentos no relatório
+  static void BeginEvent();
+  static void EndEvent(long eventIndex);
+  // Fim do run: cada thread que processou eventos entrega as amostras; o
+  // master escreve o resultado e zera.
+  static void MergeThread();
+  static void Report(int runId);
+
+ private:
+  static void AddTime(Phase phase, std::chrono::steady_clock::duration elapsed);
+  static void AddCount(Counter counter, std::uint64_t value);
+
+  static std::atomic<bool> fEnabled;
+};
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef ProfilerMessenger_h
+#define ProfilerMessenger_h
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+
+// Comandos /rpc/profile/... do perfil por evento (Profiler).
+class ProfilerMessenger : public G4UImessenger {
+ public:
+  ProfilerMessenger();
+  ~ProfilerMessenger() override;
+
+  void SetNewValue(G4UIcommand*, G4String) override;
+  G4String GetCurrentValue(G4UIcommand*) override;
+
+ private:
+  G4UIdirectory* fProfileDir = nullptr;
+  G4UIcmdWithABool* fEnableCmd = nullptr;
+  G4UIcmdWithAString* fFileCmd = nullptr;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef RandomMessenger_h
+#define RandomMessenger_h
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+
+// Comandos /rpc/random/... e /rpc/replayEvent das sementes por evento
+// (EventSeeds).
+class RandomMessenger : public G4UImessenger {
+ public:
+  RandomMessenger();
+  ~RandomMessenger() override;
+
+  void SetNewValue(G4UIcommand*, G4String) override;
+  G4String GetCurrentValue(G4UIcommand*) override;
+
+ private:
+  G4UIdirectory* fRandomDir = nullptr;
+  G4UIcmdWithAString* fSeedCmd = nullptr;
+  G4UIcmdWithAnInteger* fEventOffsetCmd = nullptr;
+  G4UIcommand* fReplayCmd = nullptr;
+};
+
+#endif
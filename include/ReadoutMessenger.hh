@@ -0,0 +1,30 @@
+#ifndef ReadoutMessenger_h
+#define ReadoutMessenger_h
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAnInteger;
+
+// Comandos /rpc/readout/... da leitura dos pads (PadReadout).
+class ReadoutMessenger : public G4UImessenger {
+ public:
+  ReadoutMessenger();
+  ~ReadoutMessenger() override;
+
+  void SetNewValue(G4UIcommand*, G4String) override;
+  G4String GetCurrentValue(G4UIcommand*) override;
+
+ private:
+  G4UIdirectory* fReadoutDir = nullptr;
+  G4UIcmdWithABool* fEnableCmd = nullptr;
+  G4UIcmdWithADouble* fThresholdCmd = nullptr;
+  G4UIcmdWithADoubleAndUnit* fTimeBinCmd = nullptr;
+  G4UIcmdWithAnInteger* fNTimeBinsCmd = nullptr;
+};
+
+#endif
@@ -3,8 +3,13 @@
 
 #include "G4UserRunAction.hh"
 #include "globals.hh"
+#include "G4Timer.hh"
+#include "G4Accumulable.hh"
+#include "RunInfo.hh"
+#include <string>
 
 class G4Run;
+class EventOutput;
 
 class RunAction : public G4UserRunAction {
  public:
@@ -13,6 +18,47 @@ class RunAction : public G4UserRunAction {
 
   virtual void BeginOfRunAction(const G4Run*);
   virtual void EndOfRunAction(const G4Run*);
+
+  EventOutput* GetEventOutput() const { return fEventOutput; }
+
+  // Resumo de um evento para a curva de eficiência (somado entre as threads
+  // por G4Accumulable). Eficiente: algum pad acima do limiar ou, sem a
+  // leitura dos pads, alguma avalanche; o cluster size é o número de pads.
+  // avalancheSize e nElectrons são as somas do evento sobre todos os gaps.
+  void AddEvent(G4bool efficient, G4double avalancheSize, G4int nElectrons, G4int nPads);
+
+  // Resultado do último run, preenchido pelo master em EndOfRunAction
+  struct Summary {
+    G4double highVoltage = 0.;   // [unidades do Geant4]
+    G4int events = 0;
+    G4double efficiency = 0.;
+    G4double efficiencyError = 0.;
+    G4double gain = 0.;          // média por evento com elétrons primários
+    G4double gainError = 0.;
+    G4double avalancheSize = 0.;
+    G4double clusterSize = 0.;   // média nos eventos eficientes
+    G4double seconds = 0.;
+  };
+  static const Summary& GetLastSummary() { return fLastSummary; }
+
+ private:
+  void PrintOutputSummary(G4int nofEvents) const;
+  void FillSummary(G4int nofEvents, G4double seconds);
+
+  static Summary fLastSummary;
+
+  G4Timer fTimer;
+  EventOutput* fEventOutput = nullptr;
+  RunInfo fRunInfo;
+  // Nome do arquivo aberto no run, já com o prefixo/sufixo do job
+  std::string fFileName;
+
+  G4Accumulable<G4int> fEfficientEvents = 0;
+  G4Accumulable<G4int> fGainEvents = 0;
+  G4Accumulable<G4double> fGainSum = 0.;
+  G4Accumulable<G4double> fGainSum2 = 0.;
+  G4Accumulable<G4double> fAvalancheSum = 0.;
+  G4Accumulable<G4double> fClusterSizeSum = 0.;
 };
 
 
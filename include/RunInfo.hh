@@ -0,0 +1,25 @@
+#ifndef RunInfo_h
+#define RunInfo_h
+
+#include "globals.hh"
+
+// Ntuple "RunInfo": metadados do run gravados junto com o ntuple Garfield,
+// uma linha por thread que processou eventos (Events é o da thread; o total
+// é a soma). Depois do rpc_merge, as linhas de todos os jobs ficam juntas.
+//
+//   Run RunSeed Job Jobs EventOffset Events Thread         job e sementes
+//   HighVoltage[V] GasGap[mm] Chambers GapsPerChamber      detector
+//   GasFile GasComposition AvalancheMode FieldModel        física
+//   Commit Geant4                                          versões
+//
+// Uma instância por thread, do RunAction, criada junto com o EventOutput.
+class RunInfo {
+ public:
+  void Book();
+  void Fill(G4int events);
+
+ private:
+  G4int fNtupleId = -1;
+};
+
+#endif
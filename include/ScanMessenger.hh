@@ -0,0 +1,36 @@
+#ifndef ScanMessenger_h
+#define ScanMessenger_h
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+
+// Comandos /rpc/scan/...: varredura de tensão para as curvas de eficiência,
+// ganho e cluster size. Cada ponto é um /run/beamOn com a mesma física já
+// inicializada; entre os pontos só a tensão muda, então o GarfieldPhysics
+// atualiza o campo no lugar e mantém meio, Sensors e tabela de ponderação.
+class ScanMessenger : public G4UImessenger {
+ public:
+  ScanMessenger();
+  ~ScanMessenger() override;
+
+  void SetNewValue(G4UIcommand*, G4String) override;
+  G4String GetCurrentValue(G4UIcommand*) override;
+
+ private:
+  void Scan(G4double vMin, G4double vMax, G4double step);
+
+  G4UIdirectory* fScanDir = nullptr;
+  G4UIcommand* fHighVoltageCmd = nullptr;
+  G4UIcmdWithAnInteger* fEventsCmd = nullptr;
+  G4UIcmdWithAString* fFileCmd = nullptr;
+
+  G4int fEvents = 1000;
+  G4String fFileName = "hv_scan.csv";
+};
+
+#endif
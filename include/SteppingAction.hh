@@ -5,6 +5,7 @@
 #include "globals.hh"
 
 class EventAction;
+class DetectorConstruction;
 class G4Step;
 
 class SteppingAction : public G4UserSteppingAction
@@ -16,7 +17,10 @@ class SteppingAction : public G4UserSteppingAction
     virtual void UserSteppingAction(const G4Step*);
 
   private:
+    void FillGasEntry(G4int pdg, G4double ekin) const;
+
     EventAction* fEventAction;
+    const DetectorConstruction* fDetector = nullptr;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef WeightingPotentialTable_h
+#define WeightingPotentialTable_h
+
+#include <vector>
+
+// Potencial de ponderação de um pad retangular, tabelado uma vez e
+// reaproveitado para todos os pads (translação) e todos os eventos.
+//
+// O gap ocupa -gap/2 < y < +gap/2. Os pads e o plano de terra ficam atrás
+// das camadas dielétricas (vidro, grafite, acrílico e os outros gaps da
+// câmara); cada pilha de camadas é trocada pela sua espessura efetiva
+// sum(t_i / eps_i), que dá o mesmo campo de ponderação uniforme de um
+// capacitor planar de várias camadas. O pad, de 2 halfX x 2 halfZ, fica em
+// y = +gap/2 + padDistance e a terra em y = -gap/2 - groundDistance
+// (ComponentAnalyticField::AddPixelOnPlaneY). O espalhamento lateral dentro
+// dos dielétricos é só aproximado por essa troca, e as permissividades são
+// nominais: a carga induzida não está calibrada.
+// O potencial é aproximado pelo produto dos perfis ao longo de x (em z = 0)
+// e de z (em x = 0), normalizado pelo valor no centro:
+//   phi(x, y, z) ~ phi(x, y, 0) * phi(0, y, z) / phi(0, y, 0)
+// Fora de halfX/halfZ + margem o potencial é tomado como zero.
+// Unidades do Garfield++ (cm).
+class WeightingPotentialTable {
+ public:
+  // Distâncias efetivas das bordas do gap até a terra e até os pads
+  void Build(double gap, double groundDistance, double padDistance,
+             double halfX, double halfZ);
+
+  // Potencial em (dx, y, dz) relativo ao centro do pad
+  double Evaluate(double dx, double y, double dz) const;
+
+  double GetRangeX() const { return fRangeX; }
+  double GetRangeZ() const { return fRangeZ; }
+  bool IsBuilt() const { return !fCenter.empty(); }
+
+ private:
+  double Interpolate(const std::vector<double>& table, int nU, double u, double y) const;
+
+  double fGap = 0.;
+  double fStep = 0.;
+  double fRangeX = 0.;
+  double fRangeZ = 0.;
+  int fNX = 0;
+  int fNZ = 0;
+  int fNY = 0;
+  // [iy * n + iu], u = |dx| ou |dz| em passos de fStep
+  std::vector<double> fAlongX;
+  std::vector<double> fAlongZ;
+  std::vector<double> fCenter;
+};
+
+#endif
@@ -19,9 +19,10 @@ void ActionInitialization::BuildForMaster() const
 void ActionInitialization::Build() const
 {
     SetUserAction(new PrimaryGeneratorAction());
-    SetUserAction(new RunAction());
+    RunAction* runAction = new RunAction();
+    SetUserAction(runAction);
     
-    EventAction* eventAction = new EventAction();
+    EventAction* eventAction = new EventAction(runAction);
     SetUserAction(eventAction);
     
     SetUserAction(new SteppingAction(eventAction));
@@ -0,0 +1,108 @@
+#include "AllocationCounter.hh"
+
+#ifdef RPC_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+#include "Log.hh"
+
+thread_local int AllocationCounter::fTrackedDepth = 0;
+thread_local int AllocationCounter::fExternalDepth = 0;
+thread_local std::uint64_t AllocationCounter::fEventCount = 0;
+
+namespace {
+  // Estatísticas do run, por thread. O primeiro evento é o aquecimento (os
+  // buffers crescem até a capacidade de trabalho) e é contado à parte.
+  thread_local std::uint64_t tEvents = 0;
+  thread_local std::uint64_t tFirstEvent = 0;
+  thread_local std::uint64_t tSteadyTotal = 0;
+  thread_local std::uint64_t tSteadyMax = 0;
+  thread_local std::uint64_t tSteadyEventsWithAllocations = 0;
+
+  void* Allocate(std::size_t size) {
+    AllocationCounter::Count();
+    if (size == 0) size = 1;
+    while (true) {
+      if (void* p = std::malloc(size)) return p;
+      std::new_handler handler = std::get_new_handler();
+      if (!handler) throw std::bad_alloc();
+      handler();
+    }
+  }
+
+  void* AllocateAligned(std::size_t size, std::size_t alignment) {
+    AllocationCounter::Count();
+    if (size == 0) size = 1;
+    size = (size + alignment - 1) / alignment * alignment;
+    while (true) {
+      if (void* p = std::aligned_alloc(alignment, size)) return p;
+      std::new_handler handler = std::get_new_handler();
+      if (!handler) throw std::bad_alloc();
+      handler();
+    }
+  }
+}
+
+void AllocationCounter::EndEvent() {
+  const std::uint64_t count = fEventCount;
+  fEventCount = 0;
+  if (tEvents++ == 0) {
+    tFirstEvent = count;
+    return;
+  }
+  tSteadyTotal += count;
+  if (count > tSteadyMax) tSteadyMax = count;
+  if (count > 0) ++tSteadyEventsWithAllocations;
+}
+
+void AllocationCounter::Report() {
+  if (tEvents > 0) {
+    const std::uint64_t steadyEvents = tEvents - 1;
+    RPC_LOG_INFO("[LOG] AllocationCounter -> " << tEvents << " eventos: " << tFirstEvent
+                 << " alocações no primeiro; depois " << tSteadyTotal << " no total ("
+                 << (steadyEvents > 0 ? static_cast<double>(tSteadyTotal) / steadyEvents : 0.)
+                 << " por evento, máximo " << tSteadyMax << ", "
+                 << tSteadyEventsWithAllocations << " eventos com alguma alocação)");
+  }
+  tEvents = 0;
+  tFirstEvent = 0;
+  tSteadyTotal = 0;
+  tSteadyMax = 0;
+  tSteadyEventsWithAllocations = 0;
+}
+
+void* operator new(std::size_t size) { return Allocate(size); }
+void* operator new[](std::size_t size) { return Allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return Allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return Allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return AllocateAligned(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return AllocateAligned(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#endif
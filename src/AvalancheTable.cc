@@ -0,0 +1,163 @@
+#include "AvalancheTable.hh"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <string>
+#include "Garfield/AvalancheMC.hh"
+#include "Randomize.hh"
+#include "Log.hh"
+
+namespace {
+  constexpr int kFormatVersion = 2;
+
+  bool SameKey(const AvalancheTable::Key& a, const AvalancheTable::Key& b) {
+    auto close = [](double u, double v) {
+      return std::abs(u - v) <= 1.e-9 * std::max(std::abs(u), std::abs(v));
+    };
+    return close(a.gap, b.gap) && close(a.hv, b.hv) &&
+           close(a.stepSize, b.stepSize) && close(a.temperature, b.temperature) &&
+           close(a.pressure, b.pressure) && a.gasFile == b.gasFile &&
+           a.composition == b.composition && a.fieldModel == b.fieldModel;
+  }
+}
+
+void AvalancheTable::Build(Garfield::AvalancheMC& avalanche, const Key& key,
+                           double yMin, double yMax, int nBins, int nSamples,
+                           int nQuantiles) {
+  fKey = key;
+  fYMin = yMin;
+  fYMax = yMax;
+  fBins.assign(nBins, Bin());
+  if (nBins <= 0 || nSamples <= 0 || nQuantiles < 2) {
+    fBins.clear();
+    return;
+  }
+
+  const double dy = (yMax - yMin) / nBins;
+  std::vector<double> sizes;
+  sizes.reserve(nSamples);
+
+  for (int i = 0; i < nBins; ++i) {
+    const double y0 = yMin + (i + 0.5) * dy;
+    sizes.clear();
+    double sumT = 0., sumT2 = 0., sumR2 = 0., sumYEnd = 0.;
+    unsigned long nEndpoints = 0;
+
+    for (int k = 0; k < nSamples; ++k) {
+      avalanche.AvalancheElectron(0., y0, 0., 0.);
+      unsigned int ne = 0, ni = 0;
+      avalanche.GetAvalancheSize(ne, ni);
+      sizes.push_back(ne);
+
+      const unsigned int n = avalanche.GetNumberOfElectronEndpoints();
+      double tSample = 0.;
+      for (unsigned int j = 0; j < n; ++j) {
+        double x1, y1, z1, t1, x2, y2, z2, t2;
+        int status;
+        avalanche.GetElectronEndpoint(j, x1, y1, z1, t1, x2, y2, z2, t2, status);
+        tSample += t2;
+        sumR2 += 0.5 * (x2 * x2 + z2 * z2);
+        sumYEnd += y2;
+      }
+      nEndpoints += n;
+      if (n > 0) tSample /= n;
+      sumT += tSample;
+      sumT2 += tSample * tSample;
+    }
+
+    std::sort(sizes.begin(), sizes.end());
+    Bin& bin = fBins[i];
+    bin.quantiles.resize(nQuantiles);
+    for (int q = 0; q < nQuantiles; ++q) {
+      const double pos = static_cast<double>(q) / (nQuantiles - 1) * (nSamples - 1);
+      const int lo = static_cast<int>(pos);
+      const int hi = std::min(lo + 1, nSamples - 1);
+      bin.quantiles[q] = sizes[lo] + (pos - lo) * (sizes[hi] - sizes[lo]);
+    }
+    bin.tMean = sumT / nSamples;
+    bin.tSigma = std::sqrt(std::max(0., sumT2 / nSamples - bin.tMean * bin.tMean));
+    bin.lateralSigma = nEndpoints > 0 ? std::sqrt(sumR2 / nEndpoints) : 0.;
+    bin.yEnd = nEndpoints > 0 ? sumYEnd / nEndpoints : yMin;
+
+    RPC_LOG_DEBUG("[LOG] AvalancheTable::Build -> y0 = " << y0 << " cm, median size = "
+                  << bin.quantiles[nQuantiles / 2] << ", t = " << bin.tMean << " ns");
+  }
+}
+
+bool AvalancheTable::Load(const std::string& fileName, const Key& key) {
+  std::ifstream in(fileName);
+  if (!in) return false;
+
+  std::string tag;
+  int version = 0;
+  Key fileKey;
+  int nBins = 0, nQuantiles = 0;
+  in >> tag >> version >> fileKey.gap >> fileKey.hv >> fileKey.stepSize
+     >> fileKey.temperature >> fileKey.pressure >> fYMin >> fYMax >> nBins >> nQuantiles;
+  // Os campos de texto podem ter espaços: uma linha cada
+  in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  std::getline(in, fileKey.gasFile);
+  std::getline(in, fileKey.composition);
+  std::getline(in, fileKey.fieldModel);
+  if (!in || tag != "AvalancheTable" || version != kFormatVersion ||
+      !SameKey(key, fileKey) || nBins <= 0 || nQuantiles < 2) {
+    fBins.clear();
+    return false;
+  }
+
+  fKey = fileKey;
+  fBins.assign(nBins, Bin());
+  for (auto& bin : fBins) {
+    in >> bin.tMean >> bin.tSigma >> bin.lateralSigma >> bin.yEnd;
+    bin.quantiles.resize(nQuantiles);
+    for (auto& q : bin.quantiles) in >> q;
+  }
+  if (!in) {
+    fBins.clear();
+    return false;
+  }
+  return true;
+}
+
+bool AvalancheTable::Save(const std::string& fileName) const {
+  if (!IsValid()) return false;
+  std::ofstream out(fileName);
+  if (!out) return false;
+
+  out.precision(10);
+  out << "AvalancheTable " << kFormatVersion << " " << fKey.gap << " "
+      << fKey.hv << " " << fKey.stepSize << " " << fKey.temperature << " "
+      << fKey.pressure << " " << fYMin << " " << fYMax << " " << fBins.size()
+      << " " << fBins.front().quantiles.size() << "\n"
+      << fKey.gasFile << "\n" << fKey.composition << "\n" << fKey.fieldModel << "\n";
+  for (const auto& bin : fBins) {
+    out << bin.tMean << " " << bin.tSigma << " " << bin.lateralSigma << " "
+        << bin.yEnd;
+    for (double q : bin.quantiles) out << " " << q;
+    out << "\n";
+  }
+  return static_cast<bool>(out);
+}
+
+AvalancheTable::Result AvalancheTable::Sample(double x, double y, double z,
+                                              double t) const {
+  const int nBins = static_cast<int>(fBins.size());
+  int i = static_cast<int>((y - fYMin) / (fYMax - fYMin) * nBins);
+  i = std::min(std::max(i, 0), nBins - 1);
+  const Bin& bin = fBins[i];
+
+  const int nQ = static_cast<int>(bin.quantiles.size());
+  const double pos = G4UniformRand() * (nQ - 1);
+  const int lo = std::min(static_cast<int>(pos), nQ - 2);
+  const double size =
+      bin.quantiles[lo] + (pos - lo) * (bin.quantiles[lo + 1] - bin.quantiles[lo]);
+
+  Result result;
+  result.size = std::round(size);
+  result.t = t + std::max(0., G4RandGauss::shoot(bin.tMean, bin.tSigma));
+  result.x = x + G4RandGauss::shoot(0., bin.lateralSigma);
+  result.y = bin.yEnd;
+  result.z = z + G4RandGauss::shoot(0., bin.lateralSigma);
+  return result;
+}
@@ -0,0 +1,155 @@
+#include "ComponentGapFieldMap.hh"
+#include <algorithm>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+bool ComponentGapFieldMap::Build(Garfield::Component& source,
+                                 double xmin, double ymin, double zmin,
+                                 double xmax, double ymax, double zmax,
+                                 int nx, int ny, int nz) {
+  Reset();
+  if (nx < 2 || ny < 2 || nz < 2 || !(xmax > xmin) || !(ymax > ymin) || !(zmax > zmin)) return false;
+
+  const int n[3] = {nx, ny, nz};
+  const double lo[3] = {xmin, ymin, zmin};
+  const double hi[3] = {xmax, ymax, zmax};
+  double step[3];
+  for (int k = 0; k < 3; ++k) {
+    fN[k] = n[k];
+    fMin[k] = lo[k];
+    fMax[k] = hi[k];
+    step[k] = (hi[k] - lo[k]) / (n[k] - 1);
+    fInvStep[k] = 1. / step[k];
+  }
+
+  fNodes.resize(static_cast<std::size_t>(nx) * ny * nz);
+  fVMin = fVMax = 0.;
+  bool first = true;
+  std::size_t index = 0;
+  for (int ix = 0; ix < nx; ++ix) {
+    // A última linha é a borda exata, sem o erro acumulado de min + i * passo
+    const double x = ix == nx - 1 ? xmax : xmin + ix * step[0];
+    for (int iy = 0; iy < ny; ++iy) {
+      const double y = iy == ny - 1 ? ymax : ymin + iy * step[1];
+      for (int iz = 0; iz < nz; ++iz) {
+        const double z = iz == nz - 1 ? zmax : zmin + iz * step[2];
+        double ex = 0., ey = 0., ez = 0., v = 0.;
+        Garfield::Medium* medium = nullptr;
+        int status = 0;
+        source.ElectricField(x, y, z, ex, ey, ez, v, medium, status);
+        Node& node = fNodes[index++];
+        node.f[0] = static_cast<float>(ex);
+        node.f[1] = static_cast<float>(ey);
+        node.f[2] = static_cast<float>(ez);
+        node.f[3] = static_cast<float>(v);
+        if (first || v < fVMin) fVMin = v;
+        if (first || v > fVMax) fVMax = v;
+        first = false;
+      }
+    }
+  }
+  m_ready = true;
+  return true;
+}
+
+void ComponentGapFieldMap::Interpolate(double x, double y, double z, float out[4]) const {
+  const double u[3] = {(x - fMin[0]) * fInvStep[0], (y - fMin[1]) * fInvStep[1],
+                       (z - fMin[2]) * fInvStep[2]};
+  int i[3];
+  float t[3];
+  for (int k = 0; k < 3; ++k) {
+    // Na borda superior usa a última célula, com t = 1
+    i[k] = std::min(static_cast<int>(u[k]), fN[k] - 2);
+    t[k] = static_cast<float>(u[k] - i[k]);
+  }
+
+  const std::size_t sz = 1;
+  const std::size_t sy = static_cast<std::size_t>(fN[2]);
+  const std::size_t sx = sy * fN[1];
+  const Node* c = &fNodes[i[0] * sx + i[1] * sy + i[2]];
+
+#if defined(__SSE__)
+  const auto lerp = [](__m128 a, __m128 b, __m128 w) {
+    return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), w));
+  };
+  const __m128 tx = _mm_set1_ps(t[0]);
+  const __m128 ty = _mm_set1_ps(t[1]);
+  const __m128 tz = _mm_set1_ps(t[2]);
+  const __m128 c00 = lerp(_mm_load_ps(c[0].f), _mm_load_ps(c[sz].f), tz);
+  const __m128 c01 = lerp(_mm_load_ps(c[sy].f), _mm_load_ps(c[sy + sz].f), tz);
+  const __m128 c10 = lerp(_mm_load_ps(c[sx].f), _mm_load_ps(c[sx + sz].f), tz);
+  const __m128 c11 = lerp(_mm_load_ps(c[sx + sy].f), _mm_load_ps(c[sx + sy + sz].f), tz);
+  _mm_storeu_ps(out, lerp(lerp(c00, c01, ty), lerp(c10, c11, ty), tx));
+#else
+  const auto lerp = [](float a, float b, float w) { return a + (b - a) * w; };
+  for (int k = 0; k < 4; ++k) {
+    const float c00 = lerp(c[0].f[k], c[sz].f[k], t[2]);
+    const float c01 = lerp(c[sy].f[k], c[sy + sz].f[k], t[2]);
+    const float c10 = lerp(c[sx].f[k], c[sx + sz].f[k], t[2]);
+    const float c11 = lerp(c[sx + sy].f[k], c[sx + sy + sz].f[k], t[2]);
+    out[k] = lerp(lerp(c00, c01, t[1]), lerp(c10, c11, t[1]), t[0]);
+  }
+#endif
+}
+
+void ComponentGapFieldMap::ElectricField(const double x, const double y, const double z,
+                                         double& ex, double& ey, double& ez,
+                                         Garfield::Medium*& m, int& status) {
+  double v = 0.;
+  ElectricField(x, y, z, ex, ey, ez, v, m, status);
+}
+
+void ComponentGapFieldMap::ElectricField(const double x, const double y, const double z,
+                                         double& ex, double& ey, double& ez, double& v,
+                                         Garfield::Medium*& m, int& status) {
+  if (!m_ready || !Inside(x, y, z)) {
+    ex = ey = ez = v = 0.;
+    m = nullptr;
+    status = -6;
+    return;
+  }
+  alignas(16) float f[4];
+  Interpolate(x, y, z, f);
+  ex = f[0];
+  ey = f[1];
+  ez = f[2];
+  v = f[3];
+  m = fMedium;
+  status = 0;
+}
+
+Garfield::Medium* ComponentGapFieldMap::GetMedium(const double x, const double y, const double z) {
+  return m_ready && Inside(x, y, z) ? fMedium : nullptr;
+}
+
+bool ComponentGapFieldMap::GetVoltageRange(double& vmin, double& vmax) {
+  vmin = fVMin;
+  vmax = fVMax;
+  return m_ready;
+}
+
+bool ComponentGapFieldMap::GetBoundingBox(double& xmin, double& ymin, double& zmin,
+                                          double& xmax, double& ymax, double& zmax) {
+  xmin = fMin[0];
+  ymin = fMin[1];
+  zmin = fMin[2];
+  xmax = fMax[0];
+  ymax = fMax[1];
+  zmax = fMax[2];
+  return m_ready;
+}
+
+// O meio é do GarfieldPhysics e sobrevive a um novo Build
+void ComponentGapFieldMap::Reset() {
+  fNodes.clear();
+  for (int k = 0; k < 3; ++k) {
+    fN[k] = 0;
+    fMin[k] = 0.;
+    fMax[k] = -1.;
+    fInvStep[k] = 0.;
+  }
+  fVMin = fVMax = 0.;
+  m_ready = false;
+}
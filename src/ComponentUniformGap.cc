@@ -0,0 +1,41 @@
+#include "ComponentUniformGap.hh"
+#include <algorithm>
+#include <limits>
+
+// O campo do gap da RPC: anodo em y = -0.1 cm a 0 V, catodo em +0.1 cm
+static_assert(ParallelPlates{-0.1, 0.1, 0., -2000.}.Ey() == 10000., "Ey = V/gap, do catodo para o anodo");
+static_assert(ParallelPlates{-0.1, 0.1, 0., -2000.}.Potential(0.1) == -2000., "potencial no catodo");
+
+void ComponentUniformGap::SetPlates(const ParallelPlates& plates) {
+  fPlates = plates;
+  fEy = plates.Ey();
+  fYMin = plates.YMin();
+  fYMax = plates.YMax();
+  m_ready = true;
+}
+
+bool ComponentUniformGap::GetVoltageRange(double& vmin, double& vmax) {
+  vmin = std::min(fPlates.vAnode, fPlates.vCathode);
+  vmax = std::max(fPlates.vAnode, fPlates.vCathode);
+  return m_ready;
+}
+
+// Sem limites em x e z; a área ativa vem do Sensor::SetArea
+bool ComponentUniformGap::GetBoundingBox(double& xmin, double& ymin, double& zmin,
+                                         double& xmax, double& ymax, double& zmax) {
+  const double inf = std::numeric_limits<double>::infinity();
+  xmin = zmin = -inf;
+  xmax = zmax = inf;
+  ymin = fYMin;
+  ymax = fYMax;
+  return m_ready;
+}
+
+// O meio é do GarfieldPhysics e sobrevive a um novo SetPlates
+void ComponentUniformGap::Reset() {
+  fPlates = ParallelPlates{0., 0., 0., 0.};
+  fEy = 0.;
+  fYMin = 0.;
+  fYMax = -1.;
+  m_ready = false;
+}
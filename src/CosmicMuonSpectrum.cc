@@ -0,0 +1,48 @@
+#include "CosmicMuonSpectrum.hh"
+#include <algorithm>
+#include <cmath>
+#include "CLHEP/Units/SystemOfUnits.h"
+
+namespace {
+  constexpr double kC1 = 0.00253;  // cm^-2 s^-1 sr^-1 (GeV/c)^-1
+  constexpr double kC2 = 0.2455;
+  constexpr double kC3 = 1.288;
+  constexpr double kC4 = -0.2555;
+  constexpr double kC5 = 0.0209;
+  constexpr int kNPoints = 512;
+}
+
+double CosmicMuonSpectrum::VerticalIntensity(double p) {
+  const double pGeV = p / CLHEP::GeV;
+  const double y = std::log10(pGeV);
+  const double index = kC2 + y * (kC3 + y * (kC4 + y * kC5));
+  return kC1 * std::pow(pGeV, -index) /
+         (CLHEP::cm2 * CLHEP::s * CLHEP::sr * CLHEP::GeV);
+}
+
+void CosmicMuonSpectrum::Build(double pMin, double pMax) {
+  fLogP.resize(kNPoints);
+  fCumulative.resize(kNPoints);
+  const double logMin = std::log(pMin);
+  const double step = (std::log(pMax) - logMin) / (kNPoints - 1);
+
+  // Trapézios em ln(p): dI = I_V(p) p dln(p)
+  double previous = 0.;
+  for (int i = 0; i < kNPoints; ++i) {
+    fLogP[i] = logMin + i * step;
+    const double p = std::exp(fLogP[i]);
+    const double density = VerticalIntensity(p) * p;
+    fCumulative[i] = i == 0 ? 0. : fCumulative[i - 1] + 0.5 * (previous + density) * step;
+    previous = density;
+  }
+  fIntegral = fCumulative.back();
+}
+
+double CosmicMuonSpectrum::SampleVerticalMomentum(double u) const {
+  const double target = u * fIntegral;
+  const auto it = std::upper_bound(fCumulative.begin(), fCumulative.end(), target);
+  const std::size_t i = std::clamp<std::size_t>(it - fCumulative.begin(), 1, fCumulative.size() - 1);
+  const double width = fCumulative[i] - fCumulative[i - 1];
+  const double f = width > 0. ? (target - fCumulative[i - 1]) / width : 0.;
+  return std::exp(fLogP[i - 1] + f * (fLogP[i] - fLogP[i - 1]));
+}
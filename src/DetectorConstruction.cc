@@ -8,29 +8,75 @@
 #include "G4LogicalVolume.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4PVPlacement.hh"
+#include "G4PVReplica.hh"
 #include "G4VisAttributes.hh"
 #include "G4Colour.hh"
 #include "G4Region.hh"
 #include "FastSimulationModel.hh"
+#include "GarfieldMessenger.hh"
+#include "DetectorMessenger.hh"
+#include "DetectorParameters.hh"
+#include "ReadoutMessenger.hh"
 #include "G4UserLimits.hh"
+#include "G4GeometryManager.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4SolidStore.hh"
+#include "G4RegionStore.hh"
 
-DetectorConstruction::DetectorConstruction() {}
+namespace {
+    // Regiões sobrevivem à reconstrução da geometria; só os volumes raiz mudam
+    G4Region* GetOrCreateRegion(const G4String& name) {
+        G4Region* region = G4RegionStore::GetInstance()->GetRegion(name, false);
+        return region ? region : new G4Region(name);
+    }
+}
 
-DetectorConstruction::~DetectorConstruction() {}
+DetectorConstruction::DetectorConstruction() {
+    fGarfieldMessenger = new GarfieldMessenger();
+    fDetectorMessenger = new DetectorMessenger();
+    fReadoutMessenger = new ReadoutMessenger();
+}
+
+DetectorConstruction::~DetectorConstruction() {
+    delete fReadoutMessenger;
+    delete fDetectorMessenger;
+    delete fGarfieldMessenger;
+}
 
 G4VPhysicalVolume* DetectorConstruction::Construct() {
-    DefineMaterials();
+    // Na reconstrução pedida pelos comandos /rpc/detector/... a geometria
+    // anterior é descartada; materiais e região são reaproveitados.
+    G4GeometryManager::GetInstance()->OpenGeometry();
+    G4PhysicalVolumeStore::GetInstance()->Clean();
+    G4LogicalVolumeStore::GetInstance()->Clean();
+    G4SolidStore::GetInstance()->Clean();
+
+    if (!fGasMaterial) DefineMaterials();
+    DetectorParameters::Instance()->Print();
+    fLayerOfVolume.clear();
     G4VPhysicalVolume* world = DefineVolumes();
     
     return world;
 }
 
+void DetectorConstruction::SetLayer(const G4LogicalVolume* volume, G4int layer) {
+    const std::size_t id = static_cast<std::size_t>(volume->GetInstanceID());
+    if (id >= fLayerOfVolume.size()) fLayerOfVolume.resize(id + 1, DetectorLayer::kNone);
+    fLayerOfVolume[id] = layer;
+}
+
 void DetectorConstruction::ConstructSDandField()
 {
+    // Chamado de novo em cada thread a cada reconstrução da geometria; o
+    // modelo fica registrado na região, que é reaproveitada.
+    static G4ThreadLocal FastSimulationModel* fastSimulationModel = nullptr;
+    if (fastSimulationModel) return;
+
     if (fGasRegion) {
         G4cout << ">>> DetectorConstruction::ConstructSDandField() -> Anexando o Fast Simulation Model à região '"
                << fGasRegion->GetName() << "'" << G4endl;
-        new FastSimulationModel("GarfieldFastSim", fGasRegion);
+        fastSimulationModel = new FastSimulationModel("GarfieldFastSim", fGasRegion);
     } else {
         G4cerr << "!!!! ERRO: Região do gás não foi criada em DefineVolumes(). O modelo rápido do Garfield não será ativado." << G4endl;
     }
@@ -83,21 +129,22 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes() {
     G4bool fCheckOverlaps = true;
 
     G4Material* worldMat = nist->FindOrBuildMaterial("G4_AIR");
-    G4double rWorld = 1.5 * m;
+    G4double rWorld = DetectorParameters::Instance()->GetWorldRadius();
     G4Sphere* solidWorld = new G4Sphere("World", 0., rWorld, 0., 2*pi, 0., pi);      
     G4LogicalVolume* logicWorld = new G4LogicalVolume(solidWorld, worldMat, "logicWorld");
     G4VPhysicalVolume* physWorld = new G4PVPlacement(0, G4ThreeVector(), logicWorld, "physWorld", 0, false, 0, fCheckOverlaps);
     logicWorld->SetVisAttributes(G4VisAttributes::GetInvisible());
     
-    G4double aluThickness = 2.5 * cm;
-    G4double acrylicThickness = 1.0 * cm;
-    G4double graphiteThickness = 1.0 * cm;
-    G4double glassThickness = 0.2 * cm; 
-    G4double gasThickness = 0.2 * cm;
-    G4double padThickness = 0.5 * cm;
+    const DetectorParameters* detector = DetectorParameters::Instance();
+    G4double aluThickness = detector->GetAluminiumThickness();
+    G4double acrylicThickness = detector->GetAcrylicThickness();
+    G4double graphiteThickness = detector->GetGraphiteThickness();
+    G4double glassThickness = detector->GetGlassThickness();
+    G4double gasThickness = detector->GetGasGap();
+    G4double padThickness = detector->GetPadThickness();
 
-    G4double dimX_Al = 128.5 * cm;
-    G4double dimZ_Al = 165.0 * cm;
+    G4double dimX_Al = detector->GetSizeX();
+    G4double dimZ_Al = detector->GetSizeZ();
 
     G4Material* aluminium = nist->FindOrBuildMaterial("G4_Al");
     G4Box* solidAlu = new G4Box("AlLayerSolid", dimX_Al / 2, aluThickness / 2, dimZ_Al / 2);
@@ -105,17 +152,17 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes() {
     logicAlu->SetVisAttributes(new G4VisAttributes(G4Colour(0.7, 0.7, 0.7))); 
 
     G4Material* acrylic = nist->FindOrBuildMaterial("G4_PLEXIGLASS");
-    G4Box* solidAcrylic = new G4Box("AcrylicBoxSolid", 125.0*cm/2, acrylicThickness/2, 155.0*cm/2);
+    G4Box* solidAcrylic = new G4Box("AcrylicBoxSolid", detector->GetAcrylicSizeX()/2, acrylicThickness/2, detector->GetAcrylicSizeZ()/2);
     G4LogicalVolume* logicAcrylic = new G4LogicalVolume(solidAcrylic, acrylic, "AcrylicBoxLV");
     logicAcrylic->SetVisAttributes(new G4VisAttributes(G4Colour(0.2, 0.6, 0.9)));
 
     G4Material* graphite = nist->FindOrBuildMaterial("G4_GRAPHITE");
-    G4Box* solidGraphite = new G4Box("GraphiteBoxSolid", 119.0*cm/2, graphiteThickness/2, 148.5*cm/2);
+    G4Box* solidGraphite = new G4Box("GraphiteBoxSolid", detector->GetGraphiteSizeX()/2, graphiteThickness/2, detector->GetGraphiteSizeZ()/2);
     G4LogicalVolume* logicGraphite = new G4LogicalVolume(solidGraphite, graphite, "GraphiteBoxLV");
     logicGraphite->SetVisAttributes(new G4VisAttributes(G4Colour(0.3, 0.3, 0.3))); 
 
     G4Material* glass = nist->FindOrBuildMaterial("G4_GLASS_PLATE");
-    G4Box* solidGlass = new G4Box("GlassBoxSolid", 120.0*cm/2, glassThickness/2, 152.0*cm/2);
+    G4Box* solidGlass = new G4Box("GlassBoxSolid", detector->GetGlassSizeX()/2, glassThickness/2, detector->GetGlassSizeZ()/2);
     G4LogicalVolume* logicGlass = new G4LogicalVolume(solidGlass, glass, "GlassBoxLV");
     logicGlass->SetVisAttributes(new G4VisAttributes(G4Colour(0.8, 1.0, 1.0, 0.3)));
 
@@ -123,19 +170,45 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes() {
     G4LogicalVolume* logicGasVolume = new G4LogicalVolume(solidGasVolume, fGasMaterial, "GasVolumeLV");
     logicGasVolume->SetVisAttributes(new G4VisAttributes(G4Colour(0.5, 0.5, 1.0, 0.3)));
 
+    SetLayer(logicAlu, DetectorLayer::kAluminium);
+    SetLayer(logicAcrylic, DetectorLayer::kAcrylic);
+    SetLayer(logicGraphite, DetectorLayer::kGraphite);
+    SetLayer(logicGlass, DetectorLayer::kGlass);
+    SetLayer(logicGasVolume, DetectorLayer::kGas);
+
+    // Cortes de produção próprios para os eletrodos (PhysicsList::SetCuts)
+    GetOrCreateRegion("RegionGlass")->AddRootLogicalVolume(logicGlass);
+    GetOrCreateRegion("RegionGraphite")->AddRootLogicalVolume(logicGraphite);
+
     //G4UserLimits* userLimits = new G4UserLimits(0.01 * mm);
     //logicGasVolume->SetUserLimits(userLimits);
+
+    // Envelope de ar de cada câmara, com metade do espaçamento acima e abaixo,
+    // replicado em y dentro do envelope da pilha: a cópia do ChamberPV é o
+    // índice da câmara (de baixo para cima).
+    G4int nChambers = detector->GetNumberOfChambers();
+    G4double chamberPitch = detector->GetChamberPitch();
+    G4Box* solidStack = new G4Box("StackSolid", dimX_Al / 2, nChambers * chamberPitch / 2, dimZ_Al / 2);
+    G4LogicalVolume* logicStack = new G4LogicalVolume(solidStack, worldMat, "StackLV");
+    logicStack->SetVisAttributes(G4VisAttributes::GetInvisible());
+    new G4PVPlacement(nullptr, G4ThreeVector(), logicStack, "StackPV", logicWorld, false, 0, fCheckOverlaps);
+
+    G4Box* solidChamber = new G4Box("ChamberSolid", dimX_Al / 2, chamberPitch / 2, dimZ_Al / 2);
+    G4LogicalVolume* logicChamber = new G4LogicalVolume(solidChamber, worldMat, "ChamberLV");
+    logicChamber->SetVisAttributes(G4VisAttributes::GetInvisible());
+    new G4PVReplica("ChamberPV", logicChamber, logicStack, kYAxis, nChambers, chamberPitch);
     
     G4double currentY = 0; 
-    G4double totalThickness = 2*aluThickness + 2*acrylicThickness + 2*graphiteThickness + 2*glassThickness + gasThickness + padThickness;
-    currentY = totalThickness / 2.0; 
+    G4double chamberThickness = detector->GetChamberThickness();
+    currentY = chamberThickness / 2.0; 
     currentY -= aluThickness / 2.0;
-    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicAlu, "AlLayerPV_Top", logicWorld, false, 1, fCheckOverlaps);
+    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicAlu, "AlLayerPV_Top", logicChamber, false, 1, fCheckOverlaps);
     currentY -= aluThickness / 2.0;
 
-    G4double xPad = 14.0 * cm;
-    G4double zPad_dim = 18.0 * cm; 
-    G4double borderThickness = 1.0 * cm;
+    G4double xPad = detector->GetPadSizeX();
+    G4double zPad_dim = detector->GetPadSizeZ();
+    G4int nPadsX = detector->GetNumberOfPadsX();
+    G4int nPadsZ = detector->GetNumberOfPadsZ();
     
     currentY -= padThickness / 2.0;
     G4double padPos_Y = currentY;
@@ -143,51 +216,57 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes() {
     G4Box* solidPad = new G4Box("Pad", xPad/2, padThickness/2, zPad_dim/2);
     G4LogicalVolume* logicPad = new G4LogicalVolume(solidPad, fPadMaterial, "logicPad");
     logicPad->SetVisAttributes(new G4VisAttributes(G4Colour(1.0, 0.5, 0.0)));
+    SetLayer(logicPad, DetectorLayer::kPads);
     
-    G4double offsetX = -3.5 * (xPad + borderThickness);
-    G4double offsetZ = -3.5 * (zPad_dim + borderThickness);
-
-    for (int j = 0; j < 8; j++) {
-        for (int i = 0; i < 8; i++) {
-            G4double posX = offsetX + j * (xPad + borderThickness);
-            G4double posZ = offsetZ + i * (zPad_dim + borderThickness);
-            new G4PVPlacement(0, G4ThreeVector(posX, padPos_Y, posZ), logicPad, "physPad", logicWorld, false, j * 8 + i, fCheckOverlaps);
+    G4double offsetX = -0.5 * (nPadsX - 1) * detector->GetPadPitchX();
+    G4double offsetZ = -0.5 * (nPadsZ - 1) * detector->GetPadPitchZ();
+
+    for (int j = 0; j < nPadsX; j++) {
+        for (int i = 0; i < nPadsZ; i++) {
+            G4double posX = offsetX + j * detector->GetPadPitchX();
+            G4double posZ = offsetZ + i * detector->GetPadPitchZ();
+            new G4PVPlacement(0, G4ThreeVector(posX, padPos_Y, posZ), logicPad, "physPad", logicChamber, false, j * nPadsZ + i, fCheckOverlaps);
         }
     }
     currentY -= padThickness / 2.0;
     
     currentY -= acrylicThickness / 2.0;
-    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicAcrylic, "AcrylicBoxPV_Top", logicWorld, false, 1, fCheckOverlaps);
+    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicAcrylic, "AcrylicBoxPV_Top", logicChamber, false, 1, fCheckOverlaps);
     currentY -= acrylicThickness / 2.0;
 
     currentY -= graphiteThickness / 2.0;
-    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicGraphite, "GraphiteBoxPV_Top", logicWorld, false, 1, fCheckOverlaps);
+    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicGraphite, "GraphiteBoxPV_Top", logicChamber, false, 1, fCheckOverlaps);
     currentY -= graphiteThickness / 2.0;
 
+    // Vidro | gás | vidro | ... | vidro: o vidro de cima é a cópia nGaps, o
+    // de baixo a 0; a cópia do GasVolumePV é o gap dentro da câmara.
+    G4int nGaps = detector->GetGapsPerChamber();
     currentY -= glassThickness / 2.0;
-    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicGlass, "GlassBoxPV_Top", logicWorld, false, 1, fCheckOverlaps);
+    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicGlass, "GlassBoxPV", logicChamber, false, nGaps, fCheckOverlaps);
     currentY -= glassThickness / 2.0;
 
-    currentY -= gasThickness / 2.0;
-    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicGasVolume, "GasVolumePV", logicWorld, false, 0, fCheckOverlaps);
-    fGasRegion = new G4Region("RegionGarfield");
-    fGasRegion->AddRootLogicalVolume(logicGasVolume);
-    currentY -= gasThickness / 2.0;
+    for (G4int gap = nGaps - 1; gap >= 0; --gap) {
+        currentY -= gasThickness / 2.0;
+        new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicGasVolume, "GasVolumePV", logicChamber, false, gap, fCheckOverlaps);
+        currentY -= gasThickness / 2.0;
 
-    currentY -= glassThickness / 2.0;
-    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicGlass, "GlassBoxPV_Bottom", logicWorld, false, 2, fCheckOverlaps);
-    currentY -= glassThickness / 2.0;
+        currentY -= glassThickness / 2.0;
+        new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicGlass, "GlassBoxPV", logicChamber, false, gap, fCheckOverlaps);
+        currentY -= glassThickness / 2.0;
+    }
+    fGasRegion = GetOrCreateRegion("RegionGarfield");
+    fGasRegion->AddRootLogicalVolume(logicGasVolume);
     
     currentY -= graphiteThickness / 2.0;
-    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicGraphite, "GraphiteBoxPV_Bottom", logicWorld, false, 2, fCheckOverlaps);
+    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicGraphite, "GraphiteBoxPV_Bottom", logicChamber, false, 2, fCheckOverlaps);
     currentY -= graphiteThickness / 2.0;
     
     currentY -= acrylicThickness / 2.0;
-    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicAcrylic, "AcrylicBoxPV_Bottom", logicWorld, false, 2, fCheckOverlaps);
+    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicAcrylic, "AcrylicBoxPV_Bottom", logicChamber, false, 2, fCheckOverlaps);
     currentY -= acrylicThickness / 2.0;
     
     currentY -= aluThickness / 2.0;
-    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicAlu, "AlLayerPV_Bottom", logicWorld, false, 2, fCheckOverlaps);
+    new G4PVPlacement(nullptr, G4ThreeVector(0, currentY, 0), logicAlu, "AlLayerPV_Bottom", logicChamber, false, 2, fCheckOverlaps);
     
     return physWorld;
 }
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "DetectorMessenger.hh"
+#include "DetectorParameters.hh"
+#include "G4RunManager.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+// Os parâmetros são compartilhados e lidos pelas threads no início de cada
+// run, então os comandos só precisam rodar no master.
+DetectorMessenger::DetectorMessenger() {
+  fDetectorDir = new G4UIdirectory("/rpc/detector/");
+  fDetectorDir->SetGuidance("Geometria e tensão da câmara.");
+
+  fGapCmd = MakeLengthCommand("/rpc/detector/gap", "Espessura do gap de gás.");
+  fGlassThicknessCmd = MakeLengthCommand("/rpc/detector/glassThickness", "Espessura de cada placa de vidro.");
+  fGraphiteThicknessCmd = MakeLengthCommand("/rpc/detector/graphiteThickness", "Espessura de cada camada de grafite.");
+  fSizeXCmd = MakeLengthCommand("/rpc/detector/sizeX", "Largura (x) do alumínio e do volume de gás.");
+  fSizeZCmd = MakeLengthCommand("/rpc/detector/sizeZ", "Comprimento (z) do alumínio e do volume de gás.");
+  fPadSizeXCmd = MakeLengthCommand("/rpc/detector/padSizeX", "Largura (x) de cada pad.");
+  fPadSizeZCmd = MakeLengthCommand("/rpc/detector/padSizeZ", "Comprimento (z) de cada pad.");
+  fPadBorderCmd = MakeLengthCommand("/rpc/detector/padBorder", "Espaço entre pads vizinhos (passo = pad + borda).");
+
+  fNPadsXCmd = new G4UIcmdWithAnInteger("/rpc/detector/nPadsX", this);
+  fNPadsXCmd->SetGuidance("Número de pads em x.");
+  fNPadsXCmd->SetParameterName("nPads", false);
+  fNPadsXCmd->SetRange("nPads > 0");
+  fNPadsXCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fNPadsXCmd->SetToBeBroadcasted(false);
+
+  fNPadsZCmd = new G4UIcmdWithAnInteger("/rpc/detector/nPadsZ", this);
+  fNPadsZCmd->SetGuidance("Número de pads em z.");
+  fNPadsZCmd->SetParameterName("nPads", false);
+  fNPadsZCmd->SetRange("nPads > 0");
+  fNPadsZCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fNPadsZCmd->SetToBeBroadcasted(false);
+
+  fGapsPerChamberCmd = new G4UIcmdWithAnInteger("/rpc/detector/gapsPerChamber", this);
+  fGapsPerChamberCmd->SetGuidance("Número de gaps de gás por câmara, separados por vidros flutuantes.");
+  fGapsPerChamberCmd->SetParameterName("nGaps", false);
+  fGapsPerChamberCmd->SetRange("nGaps > 0");
+  fGapsPerChamberCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fGapsPerChamberCmd->SetToBeBroadcasted(false);
+
+  fNChambersCmd = new G4UIcmdWithAnInteger("/rpc/detector/nChambers", this);
+  fNChambersCmd->SetGuidance("Número de câmaras empilhadas em y.");
+  fNChambersCmd->SetGuidance("A pilha precisa caber no mundo, uma esfera de 1,5 m de raio.");
+  fNChambersCmd->SetParameterName("nChambers", false);
+  fNChambersCmd->SetRange("nChambers > 0");
+  fNChambersCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fNChambersCmd->SetToBeBroadcasted(false);
+
+  fChamberSpacingCmd = MakeLengthCommand("/rpc/detector/chamberSpacing", "Espaço entre o alumínio de duas câmaras vizinhas.");
+  fChamberSpacingCmd->SetRange("value >= 0.");
+
+  fHighVoltageCmd = new G4UIcmdWithADoubleAndUnit("/rpc/detector/hv", this);
+  fHighVoltageCmd->SetGuidance("Tensão aplicada ao catodo (anodo em 0 V).");
+  fHighVoltageCmd->SetGuidance("Não reconstrói a geometria: o campo do Garfield++ é atualizado no próximo run, sem refazer os Sensors.");
+  fHighVoltageCmd->SetParameterName("hv", false);
+  fHighVoltageCmd->SetUnitCategory("Electric potential");
+  fHighVoltageCmd->SetDefaultUnit("V");
+  fHighVoltageCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fHighVoltageCmd->SetToBeBroadcasted(false);
+
+  fPrintCmd = new G4UIcmdWithoutParameter("/rpc/detector/print", this);
+  fPrintCmd->SetGuidance("Imprime os parâmetros atuais.");
+  fPrintCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fPrintCmd->SetToBeBroadcasted(false);
+}
+
+DetectorMessenger::~DetectorMessenger() {
+  delete fPrintCmd;
+  delete fHighVoltageCmd;
+  delete fChamberSpacingCmd;
+  delete fNChambersCmd;
+  delete fGapsPerChamberCmd;
+  delete fNPadsZCmd;
+  delete fNPadsXCmd;
+  delete fPadBorderCmd;
+  delete fPadSizeZCmd;
+  delete fPadSizeXCmd;
+  delete fSizeZCmd;
+  delete fSizeXCmd;
+  delete fGraphiteThicknessCmd;
+  delete fGlassThicknessCmd;
+  delete fGapCmd;
+  delete fDetectorDir;
+}
+
+G4UIcmdWithADoubleAndUnit* DetectorMessenger::MakeLengthCommand(const char* path, const char* guidance) {
+  auto* cmd = new G4UIcmdWithADoubleAndUnit(path, this);
+  cmd->SetGuidance(guidance);
+  cmd->SetParameterName("value", false);
+  cmd->SetRange("value > 0.");
+  cmd->SetUnitCategory("Length");
+  cmd->SetDefaultUnit("mm");
+  cmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  cmd->SetToBeBroadcasted(false);
+  return cmd;
+}
+
+void DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+  DetectorParameters* detector = DetectorParameters::Instance();
+
+  if (command == fPrintCmd) {
+    detector->Print();
+    return;
+  }
+  if (command == fHighVoltageCmd) {
+    detector->SetHighVoltage(fHighVoltageCmd->GetNewDoubleValue(newValue));
+    return;
+  }
+
+  if (command == fGapCmd) {
+    detector->SetGasGap(fGapCmd->GetNewDoubleValue(newValue));
+  } else if (command == fGlassThicknessCmd) {
+    detector->SetGlassThickness(fGlassThicknessCmd->GetNewDoubleValue(newValue));
+  } else if (command == fGraphiteThicknessCmd) {
+    detector->SetGraphiteThickness(fGraphiteThicknessCmd->GetNewDoubleValue(newValue));
+  } else if (command == fSizeXCmd) {
+    detector->SetSizeX(fSizeXCmd->GetNewDoubleValue(newValue));
+  } else if (command == fSizeZCmd) {
+    detector->SetSizeZ(fSizeZCmd->GetNewDoubleValue(newValue));
+  } else if (command == fPadSizeXCmd) {
+    detector->SetPadSizeX(fPadSizeXCmd->GetNewDoubleValue(newValue));
+  } else if (command == fPadSizeZCmd) {
+    detector->SetPadSizeZ(fPadSizeZCmd->GetNewDoubleValue(newValue));
+  } else if (command == fPadBorderCmd) {
+    detector->SetPadBorder(fPadBorderCmd->GetNewDoubleValue(newValue));
+  } else if (command == fNPadsXCmd) {
+    detector->SetNumberOfPadsX(fNPadsXCmd->GetNewIntValue(newValue));
+  } else if (command == fNPadsZCmd) {
+    detector->SetNumberOfPadsZ(fNPadsZCmd->GetNewIntValue(newValue));
+  } else if (command == fGapsPerChamberCmd) {
+    detector->SetGapsPerChamber(fGapsPerChamberCmd->GetNewIntValue(newValue));
+  } else if (command == fNChambersCmd) {
+    detector->SetNumberOfChambers(fNChambersCmd->GetNewIntValue(newValue));
+  } else if (command == fChamberSpacingCmd) {
+    detector->SetChamberSpacing(fChamberSpacingCmd->GetNewDoubleValue(newValue));
+  } else {
+    return;
+  }
+  // A geometria é refeita (master e workers) no próximo /run/beamOn.
+  G4RunManager::GetRunManager()->ReinitializeGeometry();
+}
+
+G4String DetectorMessenger::GetCurrentValue(G4UIcommand* command) {
+  const DetectorParameters* detector = DetectorParameters::Instance();
+  if (command == fGapCmd) {
+    return fGapCmd->ConvertToString(detector->GetGasGap(), "mm");
+  } else if (command == fGlassThicknessCmd) {
+    return fGlassThicknessCmd->ConvertToString(detector->GetGlassThickness(), "mm");
+  } else if (command == fGraphiteThicknessCmd) {
+    return fGraphiteThicknessCmd->ConvertToString(detector->GetGraphiteThickness(), "mm");
+  } else if (command == fSizeXCmd) {
+    return fSizeXCmd->ConvertToString(detector->GetSizeX(), "mm");
+  } else if (command == fSizeZCmd) {
+    return fSizeZCmd->ConvertToString(detector->GetSizeZ(), "mm");
+  } else if (command == fPadSizeXCmd) {
+    return fPadSizeXCmd->ConvertToString(detector->GetPadSizeX(), "mm");
+  } else if (command == fPadSizeZCmd) {
+    return fPadSizeZCmd->ConvertToString(detector->GetPadSizeZ(), "mm");
+  } else if (command == fPadBorderCmd) {
+    return fPadBorderCmd->ConvertToString(detector->GetPadBorder(), "mm");
+  } else if (command == fNPadsXCmd) {
+    return G4UIcommand::ConvertToString(detector->GetNumberOfPadsX());
+  } else if (command == fNPadsZCmd) {
+    return G4UIcommand::ConvertToString(detector->GetNumberOfPadsZ());
+  } else if (command == fGapsPerChamberCmd) {
+    return G4UIcommand::ConvertToString(detector->GetGapsPerChamber());
+  } else if (command == fNChambersCmd) {
+    return G4UIcommand::ConvertToString(detector->GetNumberOfChambers());
+  } else if (command == fChamberSpacingCmd) {
+    return fChamberSpacingCmd->ConvertToString(detector->GetChamberSpacing(), "mm");
+  } else if (command == fHighVoltageCmd) {
+    return fHighVoltageCmd->ConvertToString(detector->GetHighVoltage(), "V");
+  }
+  return "";
+}
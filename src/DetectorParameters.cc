@@ -0,0 +1,47 @@
+#include "DetectorParameters.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+#include "Log.hh"
+
+DetectorParameters* DetectorParameters::Instance() {
+  static DetectorParameters instance;
+  return &instance;
+}
+
+G4double DetectorParameters::GetChamberThickness() const {
+  return 2 * fAluminiumThickness + 2 * fAcrylicThickness + 2 * fGraphiteThickness +
+         (fGapsPerChamber + 1) * fGlassThickness + fGapsPerChamber * fGasGap + fPadThickness;
+}
+
+G4double DetectorParameters::GetTotalThickness() const {
+  return fNChambers * GetChamberThickness() + (fNChambers - 1) * fChamberSpacing;
+}
+
+// O gap 0 é o de baixo: acima dele ficam os outros n - 1 gaps e os seus vidros
+G4double DetectorParameters::GetGapOffset(G4int gap) const {
+  const G4double top = 0.5 * GetChamberThickness();
+  const G4double firstFromTop = top - fAluminiumThickness - fPadThickness - fAcrylicThickness -
+                                fGraphiteThickness - fGlassThickness - 0.5 * fGasGap;
+  return firstFromTop - (fGapsPerChamber - 1 - gap) * (fGasGap + fGlassThickness);
+}
+
+G4ThreeVector DetectorParameters::GetGapCenter(G4int index) const {
+  const G4int chamber = index / fGapsPerChamber;
+  const G4double chamberY = (chamber - 0.5 * (fNChambers - 1)) * GetChamberPitch();
+  return G4ThreeVector(0., chamberY + GetGapOffset(index % fGapsPerChamber), 0.);
+}
+
+G4ThreeVector DetectorParameters::GetGasCenter() const {
+  return 0.5 * (GetGapCenter(0) + GetGapCenter(GetNumberOfGaps() - 1));
+}
+
+void DetectorParameters::Print() const {
+  RPC_LOG_INFO("[LOG] DetectorParameters -> câmara " << G4BestUnit(fSizeX, "Length")
+               << " x " << G4BestUnit(fSizeZ, "Length")
+               << ", gap " << G4BestUnit(fGasGap, "Length")
+               << ", HV " << fHighVoltage / volt << " V"
+               << ", " << fNChambers << " câmara(s) x " << fGapsPerChamber << " gap(s)"
+               << ", pads " << fNPadsX << " x " << fNPadsZ
+               << " (passo " << G4BestUnit(GetPadPitchX(), "Length")
+               << " x " << G4BestUnit(GetPadPitchZ(), "Length") << ")");
+}
@@ -6,19 +6,24 @@
 #include "Analysis.hh"
 #include "Physics.hh"
 #include "RunAction.hh"
+#include "EventOutput.hh"
 #include "Randomize.hh"
-#include "G4coutDestination.hh" 
+#include "Log.hh"
+#include "AllocationCounter.hh"
+#include "Profiler.hh"
+#include "EventSeeds.hh"
 #include "G4VisManager.hh"
 #include "G4Polyline.hh"
 #include "G4Colour.hh"
 #include "G4VisAttributes.hh"
 
-EventAction::EventAction() 
+EventAction::EventAction(RunAction* runAction) 
 : G4UserEventAction(),
+  fRunAction(runAction),
   fEnergyAbs(0.),
   fEnergyGas(0.),
   fTrackLAbs(0.),
-  fAvalancheSize(0),
+  fAvalancheSize(0.),
   fGain(0.)
 {}
 
@@ -30,67 +35,104 @@ void EventAction::BeginOfEventAction(const G4Event* /*event*/) {
   fEnergyAbs = 0.;
   fEnergyGas = 0.;
   fTrackLAbs = 0.;
+  fEnergyLayer.fill(0.);
+  fTrackLayer.fill(0.);
   fAvalancheSize = 0.;
   fGain = 0.;
 
   GarfieldPhysics* garfieldPhysics = GarfieldPhysics::GetInstance();
   garfieldPhysics->Clear();
+  // Sem vis (batch) os segmentos de drift nem chegam ao buffer
+  garfieldPhysics->SetCollectDriftLines(G4VVisManager::GetConcreteInstance() != nullptr);
+  fRunAction->GetEventOutput()->Clear();
+  Profiler::BeginEvent();
 }
 
 void EventAction::EndOfEventAction(const G4Event* event) {
   G4int eventID = event->GetEventID();
-  G4cout << "\n[LOG] EventAction::EndOfEventAction -> End of Event " << eventID << G4endl;
+  // Índice global (com o offset do job), o mesmo que semeou o evento
+  const G4int eventIndex = static_cast<G4int>(EventSeeds::GetEventIndex(eventID));
+  RPC_LOG_DEBUG("[LOG] EventAction::EndOfEventAction -> End of Event " << eventID);
 
   GarfieldPhysics* garfieldPhysics = GarfieldPhysics::GetInstance();
   G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
   
-  fEnergyGas = garfieldPhysics->GetEnergyDeposit_MeV();
-  fAvalancheSize = garfieldPhysics->GetAvalancheSize();
-  fGain = garfieldPhysics->GetGain();
+  // Totais do evento: um evento pode ter vários tracks no gás
+  fEnergyGas = garfieldPhysics->GetEventEnergyDeposit_MeV();
+  fAvalancheSize = garfieldPhysics->GetEventAvalancheSize();
+  fGain = garfieldPhysics->GetEventGain();
+  garfieldPhysics->CountTruncatedEvent();
   
-  G4cout << "    -> Retrieved Avalanche Size: " << fAvalancheSize << G4endl;
-  G4cout << "    -> Retrieved Gain: " << fGain << G4endl;
+  RPC_LOG_DEBUG("    -> Retrieved Avalanche Size: " << fAvalancheSize << G4endl
+                << "    -> Retrieved Gain: " << fGain);
 
-  analysisManager->FillH1(1, fEnergyAbs);
-  analysisManager->FillH1(2, fTrackLAbs);
-  analysisManager->FillH1(3, fEnergyGas);
-  analysisManager->FillH1(4, fAvalancheSize);
-  analysisManager->FillH1(5, fGain);
+  {
+    Profiler::Scope analysisScope(Profiler::kAnalysis);
+    analysisManager->FillH1(1, fEnergyAbs);
+    analysisManager->FillH1(2, fTrackLAbs);
+    analysisManager->FillH1(3, fEnergyGas);
+    analysisManager->FillH1(4, fAvalancheSize);
+    analysisManager->FillH1(5, fGain);
+    garfieldPhysics->FlushHistograms();
+  }
 
-  analysisManager->FillNtupleDColumn(0, fEnergyAbs);
-  analysisManager->FillNtupleDColumn(1, fTrackLAbs);
-  analysisManager->FillNtupleDColumn(2, fEnergyGas);
-  analysisManager->FillNtupleDColumn(3, fAvalancheSize);
-  analysisManager->FillNtupleDColumn(4, fGain);
-  analysisManager->AddNtupleRow();
+  {
+    AllocationCounter::Tracked tracked;
+    PadReadout& padReadout = garfieldPhysics->GetPadReadout();
+    {
+      Profiler::Scope inductionScope(Profiler::kInduction);
+      padReadout.Finish();
+    }
+    Profiler::Scope analysisScope(Profiler::kAnalysis);
+    EventOutput* output = fRunAction->GetEventOutput();
+    // Os quatro argumentos do AddEvent vêm das mesmas somas sobre os gaps,
+    // para que o ganho médio do run seja o das avalanches do evento inteiro
+    G4double eventAvalancheSize = 0.;
+    G4int nElectrons = 0;
+    for (const auto& gap : garfieldPhysics->GetGapResults()) {
+      output->AddGap(gap.energy, gap.avalancheSize, gap.electrons);
+      eventAvalancheSize += gap.avalancheSize;
+      nElectrons += gap.electrons;
+    }
+    const G4int nPads = static_cast<G4int>(padReadout.GetHits().size());
+    // Sem pads, eficiente se houve avalanche em qualquer gap do evento
+    const G4bool efficient = PadReadout::IsEnabled() ? nPads > 0 : eventAvalancheSize >= 1.;
+    fRunAction->AddEvent(efficient, eventAvalancheSize, nElectrons, nPads);
+    output->Fill(EventSeeds::GetRun(), eventIndex, fEnergyAbs, fTrackLAbs, fEnergyGas, fAvalancheSize, fGain,
+                 fEnergyLayer, fTrackLayer, padReadout.GetHits());
+  }
+  AllocationCounter::EndEvent();
+  Profiler::EndEvent(eventIndex);
 
+  // Um único lote por evento, com os mesmos atributos para todas as linhas
   G4VVisManager* pVisManager = G4VVisManager::GetConcreteInstance();
-  if (pVisManager) {
-      GarfieldPhysics* garfieldPhysics = GarfieldPhysics::GetInstance();
-      const auto& driftLines = garfieldPhysics->GetDriftLines();
-      for (const auto& line : driftLines) {
-          G4Polyline polyline;
-          polyline.push_back(line.first);
-          polyline.push_back(line.second);
-          
-          G4Colour colour(0.0, 1.0, 1.0); 
-          G4VisAttributes attribs(colour);
-          polyline.SetVisAttributes(attribs);
-          
-          pVisManager->Draw(polyline);
-      }
+  const DriftLineBuffer& driftLines = garfieldPhysics->GetDriftLines();
+  if (pVisManager && driftLines.Size() > 0) {
+    static const G4VisAttributes attribs(G4Colour(0.0, 1.0, 1.0));
+    G4Polyline polyline;
+    polyline.SetVisAttributes(attribs);
+    pVisManager->BeginDraw();
+    for (const auto& line : driftLines) {
+      polyline.clear();
+      polyline.push_back(line.start);
+      polyline.push_back(line.end);
+      pVisManager->Draw(polyline);
+    }
+    pVisManager->EndDraw();
+    RPC_LOG_DEBUG("    -> Drift lines: " << driftLines.Size() << " desenhadas, "
+                  << driftLines.GetDropped() << " descartadas pela decimação");
   }
 
   G4int printModulo = G4RunManager::GetRunManager()->GetPrintProgress();
   if ((printModulo > 0) && (eventID % printModulo == 0)) {
-    G4cout << "---> End of event summary: " << eventID << G4endl;
-
-    G4cout << "   Absorber: total energy: " << std::setw(7)
+    // Um único flush (G4endl só no fim): no MT cada flush passa pelo lock da
+    // saída
+    G4cout << "---> End of event summary: " << eventID << "\n"
+           << "   Absorber: total energy: " << std::setw(7)
            << G4BestUnit(fEnergyAbs, "Energy")
            << "       total track length: " << std::setw(7)
-           << G4BestUnit(fTrackLAbs, "Length") << G4endl;
-
-    G4cout << "        Gas: total energy: " << std::setw(7)
+           << G4BestUnit(fTrackLAbs, "Length") << "\n"
+           << "        Gas: total energy: " << std::setw(7)
            << G4BestUnit(fEnergyGas, "Energy")
            << "       avalanche size: " << fAvalancheSize
            << "       gain: " << fGain << G4endl;
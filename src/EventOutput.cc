@@ -0,0 +1,203 @@
+#include "EventOutput.hh"
+#include "Analysis.hh"
+#include "AllocationCounter.hh"
+
+std::atomic<bool> EventOutput::fSchemaFrozen{false};
+std::atomic<long long> EventOutput::fWriteTime_ns{0};
+
+namespace {
+  // Capacidade inicial das colunas vetoriais; mantida entre eventos.
+  constexpr std::size_t kReservedEntries = 256;
+  constexpr G4int kRunColumn = 5;
+  constexpr G4int kEventColumn = 6;
+  constexpr G4int kFirstLayerColumn = 7;
+}
+
+EventOutput::Schema& EventOutput::GetSchema() {
+  static Schema schema;
+  return schema;
+}
+
+void EventOutput::VectorColumn::Book(const G4String& name, bool useFloat) {
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  fUseFloat = useFloat;
+  if (fUseFloat) {
+    fFloat.reserve(kReservedEntries);
+    analysisManager->CreateNtupleFColumn(name, fFloat);
+  } else {
+    fDouble.reserve(kReservedEntries);
+    analysisManager->CreateNtupleDColumn(name, fDouble);
+  }
+}
+
+void EventOutput::Book() {
+  if (fBooked) return;
+  fSchema = GetSchema();
+  fSchemaFrozen = true;
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  fNtupleId = analysisManager->CreateNtuple("Garfield", "Garfield++ event record");
+  // Colunas escalares: ids 0..4, Run e Event, e as das camadas logo depois
+  // (kFirstLayerColumn)
+  auto createScalar = [this, analysisManager](const G4String& name) {
+    if (fSchema.useFloat) analysisManager->CreateNtupleFColumn(name);
+    else analysisManager->CreateNtupleDColumn(name);
+  };
+  for (const char* name : {"Eabs", "Labs", "Egas", "AvalancheSize", "Gain"}) {
+    createScalar(name);
+  }
+  analysisManager->CreateNtupleIColumn("Run");
+  analysisManager->CreateNtupleIColumn("Event");
+  if (fSchema.layers) {
+    for (int layer = 0; layer < DetectorLayer::kNumberOfLayers; ++layer) {
+      createScalar(G4String("E") + DetectorLayer::Name(layer));
+    }
+    for (int layer = 0; layer < DetectorLayer::kNumberOfLayers; ++layer) {
+      createScalar(G4String("L") + DetectorLayer::Name(layer));
+    }
+  }
+  if (fSchema.gaps) {
+    fGapE.Book("GapE", fSchema.useFloat);
+    fGapAvalancheSize.Book("GapAvalancheSize", fSchema.useFloat);
+    fGapNe.reserve(kReservedEntries);
+    analysisManager->CreateNtupleIColumn("GapNe", fGapNe);
+  }
+  if (fSchema.clusters) {
+    fClusterGap.reserve(kReservedEntries);
+    analysisManager->CreateNtupleIColumn("ClusterGap", fClusterGap);
+    fClusterX.Book("ClusterX", fSchema.useFloat);
+    fClusterY.Book("ClusterY", fSchema.useFloat);
+    fClusterZ.Book("ClusterZ", fSchema.useFloat);
+    fClusterT.Book("ClusterT", fSchema.useFloat);
+    fClusterE.Book("ClusterE", fSchema.useFloat);
+    fClusterNe.reserve(kReservedEntries);
+    analysisManager->CreateNtupleIColumn("ClusterNe", fClusterNe);
+  }
+  if (fSchema.avalanches) {
+    fAvalancheGap.reserve(kReservedEntries);
+    analysisManager->CreateNtupleIColumn("AvalancheGap", fAvalancheGap);
+    fAvalancheX.Book("AvalancheX", fSchema.useFloat);
+    fAvalancheY.Book("AvalancheY", fSchema.useFloat);
+    fAvalancheZ.Book("AvalancheZ", fSchema.useFloat);
+    fAvalancheT.Book("AvalancheT", fSchema.useFloat);
+    fAvalancheNe.Book("AvalancheNe", fSchema.useFloat);
+  }
+  if (fSchema.endpoints) {
+    fEndpointX.Book("EndpointX", fSchema.useFloat);
+    fEndpointY.Book("EndpointY", fSchema.useFloat);
+    fEndpointZ.Book("EndpointZ", fSchema.useFloat);
+    fEndpointT.Book("EndpointT", fSchema.useFloat);
+  }
+  if (fSchema.pads) {
+    fPadId.reserve(kReservedEntries);
+    analysisManager->CreateNtupleIColumn("PadId", fPadId);
+    fPadCharge.Book("PadCharge", fSchema.useFloat);
+    fPadToT.Book("PadToT", fSchema.useFloat);
+    fPadLeadingEdge.Book("PadLeadingEdge", fSchema.useFloat);
+  }
+  analysisManager->FinishNtuple(fNtupleId);
+  fBooked = true;
+}
+
+void EventOutput::Clear() {
+  fGapE.clear();
+  fGapAvalancheSize.clear();
+  fGapNe.clear();
+  fClusterGap.clear();
+  fClusterX.clear();
+  fClusterY.clear();
+  fClusterZ.clear();
+  fClusterT.clear();
+  fClusterE.clear();
+  fClusterNe.clear();
+  fAvalancheGap.clear();
+  fAvalancheX.clear();
+  fAvalancheY.clear();
+  fAvalancheZ.clear();
+  fAvalancheT.clear();
+  fAvalancheNe.clear();
+  fEndpointX.clear();
+  fEndpointY.clear();
+  fEndpointZ.clear();
+  fEndpointT.clear();
+  fPadId.clear();
+  fPadCharge.clear();
+  fPadToT.clear();
+  fPadLeadingEdge.clear();
+}
+
+void EventOutput::AddGap(double energy, double avalancheSize, int nElectrons) {
+  if (!fBooked || !fSchema.gaps) return;
+  fGapE.push_back(energy);
+  fGapAvalancheSize.push_back(avalancheSize);
+  fGapNe.push_back(nElectrons);
+}
+
+void EventOutput::AddCluster(int gap, double x, double y, double z, double t, double energy,
+                             int nElectrons) {
+  if (!fBooked || !fSchema.clusters) return;
+  fClusterGap.push_back(gap);
+  fClusterX.push_back(x);
+  fClusterY.push_back(y);
+  fClusterZ.push_back(z);
+  fClusterT.push_back(t);
+  fClusterE.push_back(energy);
+  fClusterNe.push_back(nElectrons);
+}
+
+void EventOutput::AddAvalanche(int gap, double x, double y, double z, double t, double size) {
+  if (!fBooked || !fSchema.avalanches) return;
+  fAvalancheGap.push_back(gap);
+  fAvalancheX.push_back(x);
+  fAvalancheY.push_back(y);
+  fAvalancheZ.push_back(z);
+  fAvalancheT.push_back(t);
+  fAvalancheNe.push_back(size);
+}
+
+void EventOutput::AddEndpoint(double x, double y, double z, double t) {
+  if (!fBooked || !fSchema.endpoints) return;
+  fEndpointX.push_back(x);
+  fEndpointY.push_back(y);
+  fEndpointZ.push_back(z);
+  fEndpointT.push_back(t);
+}
+
+void EventOutput::FillScalar(G4int column, double value) {
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  if (fSchema.useFloat) analysisManager->FillNtupleFColumn(fNtupleId, column, static_cast<float>(value));
+  else analysisManager->FillNtupleDColumn(fNtupleId, column, value);
+}
+
+void EventOutput::Fill(int run, int event, double eAbs, double lAbs, double eGas,
+                       double avalancheSize, double gain, const DetectorLayer::Sums& eLayer,
+                       const DetectorLayer::Sums& lLayer, const std::vector<PadHit>& padHits) {
+  if (!fBooked) return;
+  if (fSchema.pads) {
+    for (const auto& hit : padHits) {
+      fPadId.push_back(hit.id);
+      fPadCharge.push_back(hit.charge);
+      fPadToT.push_back(hit.timeOverThreshold);
+      fPadLeadingEdge.push_back(hit.leadingEdge);
+    }
+  }
+
+  {
+    AllocationCounter::External external;
+    FillScalar(0, eAbs);
+    FillScalar(1, lAbs);
+    FillScalar(2, eGas);
+    FillScalar(3, avalancheSize);
+    FillScalar(4, gain);
+    G4AnalysisManager::Instance()->FillNtupleIColumn(fNtupleId, kRunColumn, run);
+    G4AnalysisManager::Instance()->FillNtupleIColumn(fNtupleId, kEventColumn, event);
+    if (fSchema.layers) {
+      for (int layer = 0; layer < DetectorLayer::kNumberOfLayers; ++layer) {
+        FillScalar(kFirstLayerColumn + layer, eLayer[layer]);
+        FillScalar(kFirstLayerColumn + DetectorLayer::kNumberOfLayers + layer, lLayer[layer]);
+      }
+    }
+    G4AnalysisManager::Instance()->AddNtupleRow(fNtupleId);
+  }
+  Clear();
+}
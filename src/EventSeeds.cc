@@ -0,0 +1,98 @@
+#include "EventSeeds.hh"
+#include "Randomize.hh"
+#include "Garfield/Random.hh"
+#include "G4AutoLock.hh"
+#include "Log.hh"
+
+std::uint64_t EventSeeds::fSeed = 0;
+long EventSeeds::fEventOffset = 0;
+int EventSeeds::fRun = 0;
+std::uint64_t EventSeeds::fRunSeed = 0;
+std::map<int, std::uint64_t> EventSeeds::fRunSeeds;
+bool EventSeeds::fReplay = false;
+int EventSeeds::fReplayRun = 0;
+long EventSeeds::fReplayEvent = 0;
+G4ThreadLocal std::uint64_t EventSeeds::fEventSeed = 0;
+G4ThreadLocal std::uint64_t EventSeeds::fGarfieldTracks = 0;
+
+namespace {
+  G4Mutex garfieldMutex = G4MUTEX_INITIALIZER;
+
+  // Índice reservado para a semente da AvalancheTable
+  constexpr std::uint64_t kTableStream = ~std::uint64_t(0);
+  // Fluxo do Garfield++ dentro da semente do evento (0 e 1: Geant4)
+  constexpr std::uint64_t kGarfieldStream = 2;
+
+  // Sementes do HepRandom: positivas e diferentes de zero
+  long EngineSeed(std::uint64_t value) {
+    return static_cast<long>(value % 2147483646ULL) + 1;
+  }
+}
+
+bool EventSeeds::SetReplay(int run, long event) {
+  std::uint64_t runSeed = 0;
+  auto it = fRunSeeds.find(run);
+  if (it != fRunSeeds.end()) {
+    runSeed = it->second;
+  } else if (fSeed != 0) {
+    runSeed = Mix(fSeed, static_cast<std::uint64_t>(run));
+  } else {
+    return false;
+  }
+  fReplay = true;
+  fReplayRun = run;
+  fReplayEvent = event;
+  fRunSeeds[run] = runSeed;
+  return true;
+}
+
+void EventSeeds::BeginRun(int runId) {
+  if (fReplay) {
+    fRun = fReplayRun;
+    fRunSeed = fRunSeeds[fReplayRun];
+    RPC_LOG_INFO("[LOG] EventSeeds::BeginRun -> Refazendo o evento " << fReplayEvent << " do run " << fRun
+                 << " (semente do run " << fRunSeed << ")");
+    return;
+  }
+  fRun = runId;
+  if (fSeed != 0) {
+    fRunSeed = Mix(fSeed, static_cast<std::uint64_t>(runId));
+  } else {
+    CLHEP::HepRandomEngine* engine = G4Random::getTheEngine();
+    const std::uint64_t high = static_cast<unsigned int>(*engine);
+    const std::uint64_t low = static_cast<unsigned int>(*engine);
+    fRunSeed = (high << 32) | low;
+  }
+  fRunSeeds[runId] = fRunSeed;
+  RPC_LOG_INFO("[LOG] EventSeeds::BeginRun -> Run " << runId << ": semente do run " << fRunSeed
+               << ", eventos a partir do índice " << fEventOffset);
+}
+
+void EventSeeds::SeedEvent(long eventIndex) {
+  const std::uint64_t eventSeed = Mix(fRunSeed, static_cast<std::uint64_t>(eventIndex));
+  long seeds[3] = {EngineSeed(Mix(eventSeed, 0)), EngineSeed(Mix(eventSeed, 1)), 0};
+  G4Random::setTheSeeds(seeds);
+  fEventSeed = eventSeed;
+  fGarfieldTracks = 0;
+  RPC_LOG_TRACE("[LOG] EventSeeds::SeedEvent -> Run " << fRun << ", evento " << eventIndex
+                << ": semente " << eventSeed);
+}
+
+void EventSeeds::SeedGarfieldTrack() {
+  SeedGarfield(Mix(Mix(fEventSeed, kGarfieldStream), fGarfieldTracks++));
+}
+
+void EventSeeds::SeedTableSampling() {
+  G4AutoLock lock(&garfieldMutex);
+  SeedGarfield(Mix(fRunSeed, kTableStream));
+}
+
+G4Mutex& EventSeeds::GarfieldMutex() {
+  return garfieldMutex;
+}
+
+void EventSeeds::SeedGarfield(std::uint64_t seed) {
+  // Semente 0 faria o TRandom3 usar o relógio
+  const unsigned int value = static_cast<unsigned int>(seed);
+  Garfield::randomEngine.Seed(value != 0 ? value : 1);
+}
@@ -5,52 +5,64 @@
 #include "G4Gamma.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4VPhysicalVolume.hh"
-#include "G4coutDestination.hh" 
 #include "G4VSolid.hh" 
+#include "G4VTouchable.hh"
+#include "DetectorParameters.hh"
+#include "Log.hh"
 
 FastSimulationModel::FastSimulationModel(G4String modelName, G4Region* envelope) : G4VFastSimulationModel(modelName, envelope) {
-  G4cout << "[LOG] FastSimulationModel -> Constructor called for model: " << modelName << G4endl;
+  RPC_LOG_INFO("[LOG] FastSimulationModel -> Constructor called for model: " << modelName);
   fGarfieldPhysics = GarfieldPhysics::GetInstance();
+  fApplicability = &GarfieldPhysics::GetGarfieldTable();
+  fElectron = G4Electron::ElectronDefinition();
+  fGamma = G4Gamma::GammaDefinition();
 }
 
 FastSimulationModel::FastSimulationModel(G4String modelName) : G4VFastSimulationModel(modelName) {
-  G4cout << "[LOG] FastSimulationModel -> Constructor called for model: " << modelName << G4endl;
+  RPC_LOG_INFO("[LOG] FastSimulationModel -> Constructor called for model: " << modelName);
   fGarfieldPhysics = GarfieldPhysics::GetInstance();
+  fApplicability = &GarfieldPhysics::GetGarfieldTable();
+  fElectron = G4Electron::ElectronDefinition();
+  fGamma = G4Gamma::GammaDefinition();
 }
 
 FastSimulationModel::~FastSimulationModel() {}
 
 G4bool FastSimulationModel::IsApplicable(const G4ParticleDefinition& particleType) {
-  G4String particleName = particleType.GetParticleName();
-  bool result = fGarfieldPhysics->FindParticleName(particleName, "garfield");
-  G4cout << "[LOG] FastSimulationModel::IsApplicable -> Particle: " << particleName << " -> Applicable? " << (result ? "Yes" : "No") << G4endl;
+  // Chamado ao montar as tabelas de física, com as partículas já criadas
+  GarfieldPhysics::FreezeParticleTables();
+  bool result = fApplicability->IsApplicable(GarfieldPhysics::GetParticleIndex(&particleType));
+  RPC_LOG_TRACE("[LOG] FastSimulationModel::IsApplicable -> Particle: " << particleType.GetParticleName() << " -> Applicable? " << (result ? "Yes" : "No"));
   return result;
 }
 
+// Chamado a cada step na região do gás: só o acesso à tabela congelada.
 G4bool FastSimulationModel::ModelTrigger(const G4FastTrack& fastTrack) {
-  double ekin_MeV = fastTrack.GetPrimaryTrack()->GetKineticEnergy() / MeV;
-  G4String particleName =
-      fastTrack.GetPrimaryTrack()->GetParticleDefinition()->GetParticleName();
-  bool result = fGarfieldPhysics->FindParticleNameEnergy(particleName, ekin_MeV, "garfield");
-  G4cout << "[LOG] FastSimulationModel::ModelTrigger -> Particle: " << particleName << ", E_kin: " << ekin_MeV << " MeV. Trigger? " << (result ? "Yes" : "No") << G4endl;
+  if (!GarfieldPhysics::IsEnabled()) return false;
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  bool result = fApplicability->IsApplicable(GarfieldPhysics::GetParticleIndex(track->GetParticleDefinition()),
+                                             track->GetKineticEnergy());
+  RPC_LOG_TRACE("[LOG] FastSimulationModel::ModelTrigger -> Particle: " << track->GetParticleDefinition()->GetParticleName()
+                << ", E_kin: " << track->GetKineticEnergy() / MeV << " MeV. Trigger? " << (result ? "Yes" : "No"));
   return result;
 }
 
 void FastSimulationModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep) {
-    G4cout << "\n========================================================================" << G4endl;
-    G4cout << "[LOG] FastSimulationModel::DoIt -> TRIGGERED! Handing track to GarfieldPhysics." << G4endl;
-
     // --- Obtenha informações da trajetória primária ---
     const G4Track* track = fastTrack.GetPrimaryTrack();
     G4ThreeVector localpos = fastTrack.GetPrimaryTrackLocalPosition();
     G4ThreeVector localdir = fastTrack.GetPrimaryTrackLocalDirection();
     double ekin_MeV = track->GetKineticEnergy() / MeV;
     double globalTime = track->GetGlobalTime();
-    G4String particleName = track->GetParticleDefinition()->GetParticleName();
-
-    G4cout << "    -> Particle: " << particleName << ", E_kin: " << ekin_MeV << " MeV" << G4endl;
-    G4cout << "    -> Position (cm): (" << localpos.x() / CLHEP::cm << ", " << localpos.y() / CLHEP::cm << ", " << localpos.z() / CLHEP::cm << ")" << G4endl;
-    G4cout << "========================================================================\n" << G4endl;
+    const ApplicabilityTable::Entry* entry =
+        fApplicability->Find(GarfieldPhysics::GetParticleIndex(track->GetParticleDefinition()));
+    if (!entry) return;
+    // Nome já traduzido para o Heed (kaon+ -> K+, anti_proton -> anti-proton)
+    const std::string& particleName = entry->heedName;
+
+    RPC_LOG_TRACE("[LOG] FastSimulationModel::DoIt -> TRIGGERED! Handing track to GarfieldPhysics." << G4endl
+                  << "    -> Particle: " << particleName << ", E_kin: " << ekin_MeV << " MeV" << G4endl
+                  << "    -> Position (cm): (" << localpos.x() / CLHEP::cm << ", " << localpos.y() / CLHEP::cm << ", " << localpos.z() / CLHEP::cm << ")");
     
     // --- Calcule a distância de saída do volume ---
     G4VSolid* solid = track->GetVolume()->GetLogicalVolume()->GetSolid();
@@ -58,24 +70,24 @@ void FastSimulationModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastSte
 
     if (distance < 0.) distance = 0.;
 
+    // --- Gap do track: cópia do GasVolumePV (gap na câmara) e do ChamberPV ---
+    const G4VTouchable* touchable = track->GetTouchable();
+    const G4int gap = DetectorParameters::Instance()->GetGapIndex(touchable->GetReplicaNumber(1),
+                                                                  touchable->GetCopyNumber(0));
+
     // --- Chame a simulação do Garfield++ ---
-    if (particleName == "kaon+") {
-        particleName = "K+";
-    } else if (particleName == "kaon-") {
-        particleName = "K-";
-    } else if (particleName == "anti_proton") {
-        particleName = "anti-proton";
-    }
-    
     fGarfieldPhysics->DoIt(
         particleName, ekin_MeV, globalTime, localpos.x() / CLHEP::cm,
         localpos.y() / CLHEP::cm, localpos.z() / CLHEP::cm,
-        localdir.x(), localdir.y(), localdir.z());
+        localdir.x(), localdir.y(), localdir.z(), gap);
 
-    double edep_MeV = fGarfieldPhysics->GetEnergyDeposit_MeV();
+    // A energia perdida pelo primário é a depositada no gás mais a levada
+    // pelos secundários devolvidos ao Geant4
+    double edep_MeV = fGarfieldPhysics->GetTrackEnergyDeposit_MeV();
+    double esec_MeV = fGarfieldPhysics->GetSecondaryEnergy_MeV();
     
     // --- Calcule o estado final da partícula primária ---
-    G4double final_ekin_MeV = ekin_MeV - edep_MeV;
+    G4double final_ekin_MeV = ekin_MeV - edep_MeV - esec_MeV;
     if (final_ekin_MeV < 0.) final_ekin_MeV = 0.;
     G4ThreeVector exit_pos = localpos + distance * localdir;
 
@@ -83,36 +95,29 @@ void FastSimulationModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastSte
     fastStep.ProposePrimaryTrackPathLength(distance);
     fastStep.ProposeTotalEnergyDeposited(edep_MeV * MeV);
     
-    // Define o estado da partícula na borda de saída do volume
-    fastStep.ProposePrimaryTrackFinalPosition(exit_pos);
-    fastStep.ProposePrimaryTrackFinalKineticEnergy(final_ekin_MeV * MeV);
-    fastStep.ProposePrimaryTrackFinalMomentumDirection(localdir);
-    fastStep.ProposePrimaryTrackFinalPolarization(track->GetPolarization());
+    if (fGarfieldPhysics->IsPrimaryAbsorbed() || final_ekin_MeV <= 0.) {
+        // Fóton absorvido (ou primário parado) no gás
+        fastStep.KillPrimaryTrack();
+    } else {
+        // Define o estado da partícula na borda de saída do volume
+        fastStep.ProposePrimaryTrackFinalPosition(exit_pos);
+        fastStep.ProposePrimaryTrackFinalKineticEnergy(final_ekin_MeV * MeV);
+        fastStep.ProposePrimaryTrackFinalMomentumDirection(localdir);
+        fastStep.ProposePrimaryTrackFinalPolarization(track->GetPolarization());
+    }
 
     // --- Geração de secundários (se houver) ---
-    if (!fGarfieldPhysics->GetCreateSecondariesInGeant4()) return;
+    // Só e- e gamma saem do Heed: o número de tracks é conhecido antes e as
+    // definições são as guardadas no construtor.
     const auto& secondaryParticles = fGarfieldPhysics->GetSecondaryParticles();
-
     if (secondaryParticles.empty()) return;
     fastStep.SetNumberOfSecondaryTracks(secondaryParticles.size());
 
-    G4double totalEnergySecondaries_MeV = 0.;
-
     for (const auto& sp : secondaryParticles) {
-        G4double eKin_MeV = sp.getEkin_MeV();
-        G4double time = sp.getTime();
+        const G4ParticleDefinition* definition = sp.getParticleName() == "e-" ? fElectron : fGamma;
         G4ThreeVector momentumDirection(sp.getDX(), sp.getDY(), sp.getDZ());
         G4ThreeVector position(sp.getX_mm(), sp.getY_mm(), sp.getZ_mm());
-        if (sp.getParticleName() == "e-") {
-            G4DynamicParticle particle(G4Electron::ElectronDefinition(),
-                                     momentumDirection, eKin_MeV);
-            fastStep.CreateSecondaryTrack(particle, position, time, true);
-            totalEnergySecondaries_MeV += eKin_MeV;
-        } else if (sp.getParticleName() == "gamma") {
-           G4DynamicParticle particle(G4Gamma::GammaDefinition(),
-                                      momentumDirection, eKin_MeV);
-          fastStep.CreateSecondaryTrack(particle, position, time, true);
-          totalEnergySecondaries_MeV += eKin_MeV;
-        }
+        G4DynamicParticle particle(definition, momentumDirection, sp.getEkin_MeV() * MeV);
+        fastStep.CreateSecondaryTrack(particle, position, sp.getTime() * ns, true);
     }
-}
\ No newline at end of file
+}
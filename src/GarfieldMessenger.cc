@@ -0,0 +1,368 @@
+#include "GarfieldMessenger.hh"
+#include "Physics.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UIcmdWithABool.hh"
+
+// A configuração do Garfield é compartilhada entre as threads e lida por elas
+// no início de cada run, então os comandos só precisam rodar no master. A
+// reinicialização é incremental: o gás refaz só o meio, o passo de drift só
+// a tabela de avalanche; a tensão (/rpc/detector/hv) refaz só o campo.
+GarfieldMessenger::GarfieldMessenger() {
+  fGarfieldDir = new G4UIdirectory("/garfield/");
+  fGarfieldDir->SetGuidance("Controle do modelo Garfield++.");
+
+  fEnableCmd = new G4UIcmdWithABool("/garfield/enable", this);
+  fEnableCmd->SetGuidance("Liga o modelo rápido na região do gás; desligado, só o Geant4 transporta.");
+  fEnableCmd->SetParameterName("flag", true);
+  fEnableCmd->SetDefaultValue(true);
+  fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEnableCmd->SetToBeBroadcasted(false);
+
+  fIonizationModelCmd = new G4UIcmdWithAString("/garfield/ionizationModel", this);
+  fIonizationModelCmd->SetGuidance("Modelo de ionização no gás e as faixas padrão de partículas de cada programa.");
+  fIonizationModelCmd->SetGuidance("Só antes de /run/initialize: define quais processos são montados.");
+  fIonizationModelCmd->SetParameterName("model", false);
+  fIonizationModelCmd->SetCandidates("Heed PAI PAIPhot");
+  fIonizationModelCmd->AvailableForStates(G4State_PreInit);
+  fIonizationModelCmd->SetToBeBroadcasted(false);
+
+  fSecondariesCmd = new G4UIcmdWithABool("/garfield/createSecondaries", this);
+  fSecondariesCmd->SetGuidance("Devolve ao Geant4 os secundários (delta-elétrons, fótons) do Heed.");
+  fSecondariesCmd->SetParameterName("flag", true);
+  fSecondariesCmd->SetDefaultValue(true);
+  fSecondariesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSecondariesCmd->SetToBeBroadcasted(false);
+
+  fSecondariesDir = new G4UIdirectory("/garfield/secondaries/");
+  fSecondariesDir->SetGuidance("Limiares dos secundários do Heed devolvidos ao Geant4 (/garfield/createSecondaries).");
+
+  fElectronThresholdCmd = new G4UIcmdWithADoubleAndUnit("/garfield/secondaries/electronThreshold", this);
+  fElectronThresholdCmd->SetGuidance("Delta-elétrons acima deste valor vão para o Geant4; abaixo, o Heed os transporta.");
+  fElectronThresholdCmd->SetParameterName("energy", false);
+  fElectronThresholdCmd->SetRange("energy >= 0");
+  fElectronThresholdCmd->SetUnitCategory("Energy");
+  fElectronThresholdCmd->SetDefaultUnit("keV");
+  fElectronThresholdCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fElectronThresholdCmd->SetToBeBroadcasted(false);
+
+  fPhotonThresholdCmd = new G4UIcmdWithADoubleAndUnit("/garfield/secondaries/photonThreshold", this);
+  fPhotonThresholdCmd->SetGuidance("Fótons de fluorescência acima deste valor vão para o Geant4; abaixo, são absorvidos no gás.");
+  fPhotonThresholdCmd->SetParameterName("energy", false);
+  fPhotonThresholdCmd->SetRange("energy >= 0");
+  fPhotonThresholdCmd->SetUnitCategory("Energy");
+  fPhotonThresholdCmd->SetDefaultUnit("keV");
+  fPhotonThresholdCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fPhotonThresholdCmd->SetToBeBroadcasted(false);
+
+  fAvalancheDir = new G4UIdirectory("/garfield/avalanche/");
+  fAvalancheDir->SetGuidance("Transporte dos elétrons de ionização no gap.");
+
+  fAvalancheModeCmd = new G4UIcmdWithAString("/garfield/avalanche/mode", this);
+  fAvalancheModeCmd->SetGuidance("full: AvalancheMC para cada elétron primário.");
+  fAvalancheModeCmd->SetGuidance("parameterized: tabela de resposta em função da profundidade no gap.");
+  fAvalancheModeCmd->SetParameterName("mode", false);
+  fAvalancheModeCmd->SetCandidates("full parameterized");
+  fAvalancheModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fAvalancheModeCmd->SetToBeBroadcasted(false);
+
+  fTableBinsCmd = new G4UIcmdWithAnInteger("/garfield/avalanche/tableBins", this);
+  fTableBinsCmd->SetGuidance("Número de fatias em y da tabela parametrizada.");
+  fTableBinsCmd->SetParameterName("nBins", false);
+  fTableBinsCmd->SetRange("nBins > 0");
+  fTableBinsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fTableBinsCmd->SetToBeBroadcasted(false);
+
+  fTableSamplesCmd = new G4UIcmdWithAnInteger("/garfield/avalanche/tableSamples", this);
+  fTableSamplesCmd->SetGuidance("Avalanches AvalancheMC amostradas por fatia da tabela.");
+  fTableSamplesCmd->SetParameterName("nSamples", false);
+  fTableSamplesCmd->SetRange("nSamples > 0");
+  fTableSamplesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fTableSamplesCmd->SetToBeBroadcasted(false);
+
+  fTableFileCmd = new G4UIcmdWithAString("/garfield/avalanche/tableFile", this);
+  fTableFileCmd->SetGuidance("Arquivo de cache da tabela: lido se compatível, senão gravado.");
+  fTableFileCmd->SetParameterName("fileName", false);
+  fTableFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fTableFileCmd->SetToBeBroadcasted(false);
+
+  fDriftStepCmd = new G4UIcmdWithADoubleAndUnit("/garfield/avalanche/driftStep", this);
+  fDriftStepCmd->SetGuidance("Passo em distância do AvalancheMC (e da tabela parametrizada).");
+  fDriftStepCmd->SetParameterName("step", false);
+  fDriftStepCmd->SetRange("step > 0");
+  fDriftStepCmd->SetUnitCategory("Length");
+  fDriftStepCmd->SetDefaultUnit("um");
+  fDriftStepCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fDriftStepCmd->SetToBeBroadcasted(false);
+
+  fSaturationCmd = new G4UIcmdWithAString("/garfield/avalanche/saturation", this);
+  fSaturationCmd->SetGuidance("off: avalanches sem limite.");
+  fSaturationCmd->SetGuidance("truncate: avalanche limitada a sizeLimit e, acima de eventLimit no evento,");
+  fSaturationCmd->SetGuidance("  só 1 a cada sampleStride elétrons primários é transportado (com esse peso).");
+  fSaturationCmd->SetGuidance("spaceCharge: como truncate, com n -> n_sat (1 - exp(-n/n_sat)) por avalanche.");
+  fSaturationCmd->SetParameterName("mode", false);
+  fSaturationCmd->SetCandidates("off truncate spaceCharge");
+  fSaturationCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSaturationCmd->SetToBeBroadcasted(false);
+
+  fSizeLimitCmd = new G4UIcmdWithAnInteger("/garfield/avalanche/sizeLimit", this);
+  fSizeLimitCmd->SetGuidance("Elétrons em uma avalanche a partir dos quais o AvalancheMC para.");
+  fSizeLimitCmd->SetParameterName("size", false);
+  fSizeLimitCmd->SetRange("size > 0");
+  fSizeLimitCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSizeLimitCmd->SetToBeBroadcasted(false);
+
+  fEventLimitCmd = new G4UIcmdWithADouble("/garfield/avalanche/eventLimit", this);
+  fEventLimitCmd->SetGuidance("Elétrons de avalanche no evento a partir dos quais os primários são amostrados.");
+  fEventLimitCmd->SetParameterName("size", false);
+  fEventLimitCmd->SetRange("size > 0");
+  fEventLimitCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEventLimitCmd->SetToBeBroadcasted(false);
+
+  fSampleStrideCmd = new G4UIcmdWithAnInteger("/garfield/avalanche/sampleStride", this);
+  fSampleStrideCmd->SetGuidance("Passo da amostragem dos primários acima de eventLimit.");
+  fSampleStrideCmd->SetParameterName("stride", false);
+  fSampleStrideCmd->SetRange("stride > 0");
+  fSampleStrideCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSampleStrideCmd->SetToBeBroadcasted(false);
+
+  fSaturationSizeCmd = new G4UIcmdWithADouble("/garfield/avalanche/saturationSize", this);
+  fSaturationSizeCmd->SetGuidance("n_sat do modo spaceCharge: tamanho em que a carga espacial satura a avalanche.");
+  fSaturationSizeCmd->SetParameterName("size", false);
+  fSaturationSizeCmd->SetRange("size > 0");
+  fSaturationSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSaturationSizeCmd->SetToBeBroadcasted(false);
+
+  fGasDir = new G4UIdirectory("/garfield/gas/");
+  fGasDir->SetGuidance("Meio gasoso (MediumMagboltz).");
+
+  fGasFileCmd = new G4UIcmdWithAString("/garfield/gas/file", this);
+  fGasFileCmd->SetGuidance("Tabela .gas do Magboltz (e o cache <arquivo>.gas.bin).");
+  fGasFileCmd->SetParameterName("fileName", false);
+  fGasFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fGasFileCmd->SetToBeBroadcasted(false);
+
+  fGasCompositionCmd = new G4UIcmdWithAString("/garfield/gas/composition", this);
+  fGasCompositionCmd->SetGuidance("Composição da tabela .gas, entre aspas: \"ic4h10 5 sf6 5 c2h2f4 90\".");
+  fGasCompositionCmd->SetGuidance("Até 6 pares <gás> <fração>; precisa coincidir com a do arquivo.");
+  fGasCompositionCmd->SetParameterName("composition", false);
+  fGasCompositionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fGasCompositionCmd->SetToBeBroadcasted(false);
+
+  fGasCacheCmd = new G4UIcmdWithABool("/garfield/gas/cache", this);
+  fGasCacheCmd->SetGuidance("Usa o cache binário <arquivo>.gas.bin (gravado a partir do .gas se obsoleto).");
+  fGasCacheCmd->SetParameterName("flag", true);
+  fGasCacheCmd->SetDefaultValue(true);
+  fGasCacheCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fGasCacheCmd->SetToBeBroadcasted(false);
+
+  fFieldDir = new G4UIdirectory("/garfield/field/");
+  fFieldDir->SetGuidance("Componente do campo elétrico no gap.");
+
+  fFieldModelCmd = new G4UIcmdWithAString("/garfield/field/model", this);
+  fFieldModelCmd->SetGuidance("uniform: campo constante entre as placas, sem a célula genérica (padrão).");
+  fFieldModelCmd->SetGuidance("analytic: ComponentAnalyticField com os dois planos (referência).");
+  fFieldModelCmd->SetGuidance("map: grade 3D amostrada do analytic, interpolação trilinear.");
+  fFieldModelCmd->SetParameterName("model", false);
+  fFieldModelCmd->SetCandidates("uniform analytic map");
+  fFieldModelCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fFieldModelCmd->SetToBeBroadcasted(false);
+
+  fFieldMapPitchCmd = new G4UIcmdWithADoubleAndUnit("/garfield/field/mapPitch", this);
+  fFieldMapPitchCmd->SetGuidance("Espaçamento dos nós do mapa em x e z.");
+  fFieldMapPitchCmd->SetParameterName("pitch", false);
+  fFieldMapPitchCmd->SetRange("pitch > 0");
+  fFieldMapPitchCmd->SetUnitCategory("Length");
+  fFieldMapPitchCmd->SetDefaultUnit("mm");
+  fFieldMapPitchCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fFieldMapPitchCmd->SetToBeBroadcasted(false);
+
+  fFieldMapPlanesCmd = new G4UIcmdWithAnInteger("/garfield/field/mapPlanes", this);
+  fFieldMapPlanesCmd->SetGuidance("Número de planos de nós do mapa através do gap (y).");
+  fFieldMapPlanesCmd->SetParameterName("nPlanes", false);
+  fFieldMapPlanesCmd->SetRange("nPlanes > 1");
+  fFieldMapPlanesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fFieldMapPlanesCmd->SetToBeBroadcasted(false);
+
+  fVisDir = new G4UIdirectory("/garfield/vis/");
+  fVisDir->SetGuidance("Linhas de drift desenhadas com o vis ativo (sem vis, não são guardadas).");
+
+  fMaxDriftLinesCmd = new G4UIcmdWithAnInteger("/garfield/vis/maxDriftLines", this);
+  fMaxDriftLinesCmd->SetGuidance("Máximo de linhas de drift desenhadas por evento (0 = nenhuma).");
+  fMaxDriftLinesCmd->SetParameterName("nLines", false);
+  fMaxDriftLinesCmd->SetRange("nLines >= 0");
+  fMaxDriftLinesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fMaxDriftLinesCmd->SetToBeBroadcasted(false);
+
+  fDriftLineCellCmd = new G4UIcmdWithADoubleAndUnit("/garfield/vis/driftLineCell", this);
+  fDriftLineCellCmd->SetGuidance("Lado da célula da decimação: uma linha por célula, pelo ponto inicial (0 = sem decimação).");
+  fDriftLineCellCmd->SetParameterName("cell", false);
+  fDriftLineCellCmd->SetRange("cell >= 0");
+  fDriftLineCellCmd->SetUnitCategory("Length");
+  fDriftLineCellCmd->SetDefaultUnit("mm");
+  fDriftLineCellCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fDriftLineCellCmd->SetToBeBroadcasted(false);
+}
+
+GarfieldMessenger::~GarfieldMessenger() {
+  delete fDriftLineCellCmd;
+  delete fMaxDriftLinesCmd;
+  delete fVisDir;
+  delete fFieldMapPlanesCmd;
+  delete fFieldMapPitchCmd;
+  delete fFieldModelCmd;
+  delete fFieldDir;
+  delete fGasCacheCmd;
+  delete fGasCompositionCmd;
+  delete fGasFileCmd;
+  delete fGasDir;
+  delete fSaturationSizeCmd;
+  delete fSampleStrideCmd;
+  delete fEventLimitCmd;
+  delete fSizeLimitCmd;
+  delete fSaturationCmd;
+  delete fDriftStepCmd;
+  delete fTableFileCmd;
+  delete fTableSamplesCmd;
+  delete fTableBinsCmd;
+  delete fAvalancheModeCmd;
+  delete fAvalancheDir;
+  delete fPhotonThresholdCmd;
+  delete fElectronThresholdCmd;
+  delete fSecondariesDir;
+  delete fSecondariesCmd;
+  delete fIonizationModelCmd;
+  delete fEnableCmd;
+  delete fGarfieldDir;
+}
+
+void GarfieldMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+  if (command == fEnableCmd) {
+    GarfieldPhysics::SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+  } else if (command == fIonizationModelCmd) {
+    GarfieldPhysics::GetInstance()->SetIonizationModel(newValue);
+  } else if (command == fSecondariesCmd) {
+    GarfieldPhysics::EnableCreateSecondariesInGeant4(fSecondariesCmd->GetNewBoolValue(newValue));
+  } else if (command == fElectronThresholdCmd) {
+    GarfieldPhysics::SetSecondaryThresholds(fElectronThresholdCmd->GetNewDoubleValue(newValue) / eV,
+                                            GarfieldPhysics::GetSecondaryPhotonThreshold());
+  } else if (command == fPhotonThresholdCmd) {
+    GarfieldPhysics::SetSecondaryThresholds(GarfieldPhysics::GetSecondaryElectronThreshold(),
+                                            fPhotonThresholdCmd->GetNewDoubleValue(newValue) / eV);
+  } else if (command == fAvalancheModeCmd) {
+    GarfieldPhysics::SetAvalancheMode(newValue == "parameterized" ? GarfieldPhysics::AvalancheMode::Parameterized
+                                                                  : GarfieldPhysics::AvalancheMode::Full);
+  } else if (command == fTableBinsCmd) {
+    GarfieldPhysics::SetAvalancheTableBinning(
+        fTableBinsCmd->GetNewIntValue(newValue),
+        GarfieldPhysics::GetAvalancheTableSamples());
+  } else if (command == fTableSamplesCmd) {
+    GarfieldPhysics::SetAvalancheTableBinning(
+        GarfieldPhysics::GetAvalancheTableBins(),
+        fTableSamplesCmd->GetNewIntValue(newValue));
+  } else if (command == fTableFileCmd) {
+    GarfieldPhysics::SetAvalancheTableFile(newValue);
+  } else if (command == fDriftStepCmd) {
+    GarfieldPhysics::SetDriftStep(fDriftStepCmd->GetNewDoubleValue(newValue) / cm);
+  } else if (command == fSaturationCmd) {
+    GarfieldPhysics::SetSaturationMode(newValue == "truncate"      ? GarfieldPhysics::SaturationMode::Truncate
+                                       : newValue == "spaceCharge" ? GarfieldPhysics::SaturationMode::SpaceCharge
+                                                                   : GarfieldPhysics::SaturationMode::Off);
+  } else if (command == fSizeLimitCmd) {
+    GarfieldPhysics::SetAvalancheSizeLimit(fSizeLimitCmd->GetNewIntValue(newValue));
+  } else if (command == fEventLimitCmd) {
+    GarfieldPhysics::SetEventSizeLimit(fEventLimitCmd->GetNewDoubleValue(newValue));
+  } else if (command == fSampleStrideCmd) {
+    GarfieldPhysics::SetSampleStride(fSampleStrideCmd->GetNewIntValue(newValue));
+  } else if (command == fSaturationSizeCmd) {
+    GarfieldPhysics::SetSaturationSize(fSaturationSizeCmd->GetNewDoubleValue(newValue));
+  } else if (command == fGasFileCmd) {
+    GarfieldPhysics::SetGasFile(newValue);
+  } else if (command == fGasCompositionCmd) {
+    GarfieldPhysics::SetGasComposition(newValue);
+  } else if (command == fGasCacheCmd) {
+    GarfieldPhysics::SetUseGasCache(fGasCacheCmd->GetNewBoolValue(newValue));
+  } else if (command == fFieldModelCmd) {
+    GarfieldPhysics::SetFieldModel(newValue == "analytic" ? GarfieldPhysics::FieldModel::Analytic
+                                   : newValue == "map"    ? GarfieldPhysics::FieldModel::Map
+                                                          : GarfieldPhysics::FieldModel::Uniform);
+  } else if (command == fFieldMapPitchCmd) {
+    GarfieldPhysics::SetFieldMapBinning(fFieldMapPitchCmd->GetNewDoubleValue(newValue) / cm,
+                                        GarfieldPhysics::GetFieldMapPlanes());
+  } else if (command == fFieldMapPlanesCmd) {
+    GarfieldPhysics::SetFieldMapBinning(GarfieldPhysics::GetFieldMapPitch(),
+                                        fFieldMapPlanesCmd->GetNewIntValue(newValue));
+  } else if (command == fMaxDriftLinesCmd) {
+    GarfieldPhysics::SetDriftLineLimits(fMaxDriftLinesCmd->GetNewIntValue(newValue),
+                                        GarfieldPhysics::GetDriftLineCell());
+  } else if (command == fDriftLineCellCmd) {
+    GarfieldPhysics::SetDriftLineLimits(GarfieldPhysics::GetMaxDriftLines(),
+                                        fDriftLineCellCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+G4String GarfieldMessenger::GetCurrentValue(G4UIcommand* command) {
+  if (command == fEnableCmd) {
+    return G4UIcommand::ConvertToString(GarfieldPhysics::IsEnabled());
+  } else if (command == fIonizationModelCmd) {
+    return GarfieldPhysics::GetInstance()->GetIonizationModel();
+  } else if (command == fSecondariesCmd) {
+    return G4UIcommand::ConvertToString(GarfieldPhysics::GetCreateSecondariesInGeant4());
+  } else if (command == fElectronThresholdCmd) {
+    return fElectronThresholdCmd->ConvertToString(GarfieldPhysics::GetSecondaryElectronThreshold() * eV, "keV");
+  } else if (command == fPhotonThresholdCmd) {
+    return fPhotonThresholdCmd->ConvertToString(GarfieldPhysics::GetSecondaryPhotonThreshold() * eV, "keV");
+  } else if (command == fAvalancheModeCmd) {
+    switch (GarfieldPhysics::GetAvalancheMode()) {
+      case GarfieldPhysics::AvalancheMode::Parameterized: return "parameterized";
+      default: return "full";
+    }
+  } else if (command == fDriftStepCmd) {
+    return fDriftStepCmd->ConvertToString(GarfieldPhysics::GetDriftStep() * cm, "um");
+  } else if (command == fTableBinsCmd) {
+    return G4UIcommand::ConvertToString(GarfieldPhysics::GetAvalancheTableBins());
+  } else if (command == fTableSamplesCmd) {
+    return G4UIcommand::ConvertToString(GarfieldPhysics::GetAvalancheTableSamples());
+  } else if (command == fTableFileCmd) {
+    return GarfieldPhysics::GetAvalancheTableFile();
+  } else if (command == fSaturationCmd) {
+    switch (GarfieldPhysics::GetSaturationMode()) {
+      case GarfieldPhysics::SaturationMode::Truncate: return "truncate";
+      case GarfieldPhysics::SaturationMode::SpaceCharge: return "spaceCharge";
+      default: return "off";
+    }
+  } else if (command == fSizeLimitCmd) {
+    return G4UIcommand::ConvertToString(static_cast<G4int>(GarfieldPhysics::GetAvalancheSizeLimit()));
+  } else if (command == fEventLimitCmd) {
+    return G4UIcommand::ConvertToString(GarfieldPhysics::GetEventSizeLimit());
+  } else if (command == fSampleStrideCmd) {
+    return G4UIcommand::ConvertToString(GarfieldPhysics::GetSampleStride());
+  } else if (command == fSaturationSizeCmd) {
+    return G4UIcommand::ConvertToString(GarfieldPhysics::GetSaturationSize());
+  } else if (command == fGasFileCmd) {
+    return GarfieldPhysics::GetGasFile();
+  } else if (command == fGasCompositionCmd) {
+    return GarfieldPhysics::GetGasComposition();
+  } else if (command == fGasCacheCmd) {
+    return G4UIcommand::ConvertToString(GarfieldPhysics::GetUseGasCache());
+  } else if (command == fFieldModelCmd) {
+    switch (GarfieldPhysics::GetFieldModel()) {
+      case GarfieldPhysics::FieldModel::Analytic: return "analytic";
+      case GarfieldPhysics::FieldModel::Map: return "map";
+      default: return "uniform";
+    }
+  } else if (command == fFieldMapPitchCmd) {
+    return fFieldMapPitchCmd->ConvertToString(GarfieldPhysics::GetFieldMapPitch() * cm, "mm");
+  } else if (command == fFieldMapPlanesCmd) {
+    return G4UIcommand::ConvertToString(GarfieldPhysics::GetFieldMapPlanes());
+  } else if (command == fMaxDriftLinesCmd) {
+    return G4UIcommand::ConvertToString(GarfieldPhysics::GetMaxDriftLines());
+  } else if (command == fDriftLineCellCmd) {
+    return fDriftLineCellCmd->ConvertToString(GarfieldPhysics::GetDriftLineCell(), "mm");
+  }
+  return "";
+}
@@ -0,0 +1,439 @@
+#include "GasTableCache.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Garfield/MediumGas.hh"
+
+namespace {
+
+constexpr char kMagic[8] = {'R', 'P', 'C', 'G', 'A', 'S', '\0', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kKeyLength = 256;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t nTables;
+  char composition[kKeyLength];
+  double temperature;
+  double pressure;
+  double w;
+  double fano;
+  int64_t sourceMtime;
+  uint64_t sourceSize;
+  uint64_t nE;
+  uint64_t nB;
+  uint64_t nA;
+};
+
+using Getter = std::function<bool(Garfield::MediumGas&, size_t, size_t, size_t, double&)>;
+using Setter = std::function<bool(Garfield::MediumGas&, size_t, size_t, size_t, double)>;
+
+struct Table {
+  uint32_t id;
+  Getter get;
+  Setter set;
+};
+
+// O id de cada tabela faz parte do formato: não renumerar.
+const std::vector<Table>& Tables() {
+  static const std::vector<Table> tables = {
+    {1, [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double& v) { return g.GetElectronVelocityE(i, j, k, v); },
+        [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double v) { return g.SetElectronVelocityE(i, j, k, v); }},
+    {2, [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double& v) { return g.GetElectronVelocityB(i, j, k, v); },
+        [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double v) { return g.SetElectronVelocityB(i, j, k, v); }},
+    {3, [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double& v) { return g.GetElectronVelocityExB(i, j, k, v); },
+        [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double v) { return g.SetElectronVelocityExB(i, j, k, v); }},
+    {4, [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double& v) { return g.GetElectronLongitudinalDiffusion(i, j, k, v); },
+        [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double v) { return g.SetElectronLongitudinalDiffusion(i, j, k, v); }},
+    {5, [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double& v) { return g.GetElectronTransverseDiffusion(i, j, k, v); },
+        [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double v) { return g.SetElectronTransverseDiffusion(i, j, k, v); }},
+    {6, [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double& v) { return g.GetElectronTownsend(i, j, k, v); },
+        [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double v) { return g.SetElectronTownsend(i, j, k, v); }},
+    {7, [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double& v) { return g.GetElectronAttachment(i, j, k, v); },
+        [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double v) { return g.SetElectronAttachment(i, j, k, v); }},
+    {8, [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double& v) { return g.GetElectronLorentzAngle(i, j, k, v); },
+        [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double v) { return g.SetElectronLorentzAngle(i, j, k, v); }},
+    {9, [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double& v) { return g.GetIonMobility(i, j, k, v); },
+        [](Garfield::MediumGas& g, size_t i, size_t j, size_t k, double v) { return g.SetIonMobility(i, j, k, v); }},
+  };
+  return tables;
+}
+
+bool SourceStamp(const std::string& sourceFile, int64_t& mtime, uint64_t& size) {
+  struct stat st;
+  if (stat(sourceFile.c_str(), &st) != 0) return false;
+  mtime = static_cast<int64_t>(st.st_mtime);
+  size = static_cast<uint64_t>(st.st_size);
+  return true;
+}
+
+// Arquivo mapeado somente leitura, desmapeado ao sair de escopo.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& fileName) {
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED) {
+        fData = static_cast<const char*>(p);
+        fSize = static_cast<size_t>(st.st_size);
+      }
+    }
+    close(fd);
+  }
+  ~MappedFile() {
+    if (fData) munmap(const_cast<char*>(fData), fSize);
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* Data() const { return fData; }
+  size_t Size() const { return fSize; }
+
+ private:
+  const char* fData = nullptr;
+  size_t fSize = 0;
+};
+
+void SetReason(std::string* reason, const std::string& text) {
+  if (reason) *reason = text;
+}
+
+std::vector<std::pair<std::string, double> > ParseCompositionKey(const std::string& key) {
+  std::vector<std::pair<std::string, double> > components;
+  std::istringstream in(key);
+  std::string item;
+  while (std::getline(in, item, ',')) {
+    const size_t colon = item.rfind(':');
+    if (colon == std::string::npos) continue;
+    components.emplace_back(item.substr(0, colon), std::atof(item.c_str() + colon + 1));
+  }
+  return components;
+}
+
+// Transporte tabulado de um elétron com E ao longo de z e sem campo magnético
+struct Transport {
+  double velocity = 0.;
+  double townsend = 0.;
+  double attachment = 0.;
+};
+
+Transport Evaluate(Garfield::MediumGas& gas, double e) {
+  Transport t;
+  double vx = 0., vy = 0.;
+  gas.ElectronVelocity(0., 0., e, 0., 0., 0., vx, vy, t.velocity);
+  gas.ElectronTownsend(0., 0., e, 0., 0., 0., t.townsend);
+  gas.ElectronAttachment(0., 0., e, 0., 0., 0., t.attachment);
+  return t;
+}
+
+// Primeiro ponto da grade com valor não nulo: o limiar que o LoadGasFile lê
+// do .gas e que o cache não guarda.
+size_t Onset(const std::vector<Transport>& values, double Transport::*member) {
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (values[i].*member > 0.) return i;
+  }
+  return values.size();
+}
+
+// Campos de teste [V/cm]: a grade, os pontos médios, abaixo e acima dela e
+// kOnsetPoints pontos entre o último ponto nulo e o primeiro não nulo do
+// Townsend e do attachment.
+std::vector<double> ProbeFields(Garfield::MediumGas& gas, const std::vector<double>& efields) {
+  constexpr int kOnsetPoints = 16;
+  std::vector<double> probes(efields);
+  for (size_t i = 0; i + 1 < efields.size(); ++i) probes.push_back(0.5 * (efields[i] + efields[i + 1]));
+  probes.push_back(0.5 * efields.front());
+  probes.push_back(1.5 * efields.back());
+
+  std::vector<Transport> grid;
+  for (double e : efields) grid.push_back(Evaluate(gas, e));
+  for (double Transport::*member : {&Transport::townsend, &Transport::attachment}) {
+    const size_t onset = Onset(grid, member);
+    if (onset == 0 || onset >= efields.size()) continue;
+    const double lo = efields[onset - 1], hi = efields[onset];
+    for (int k = 1; k < kOnsetPoints; ++k) probes.push_back(lo + (hi - lo) * k / kOnsetPoints);
+  }
+  std::sort(probes.begin(), probes.end());
+  return probes;
+}
+
+}
+
+std::string GasTableCache::CompositionKey(Garfield::MediumGas& gas) {
+  std::vector<std::pair<std::string, double> > components(6);
+  gas.GetComposition(components[0].first, components[0].second,
+                     components[1].first, components[1].second,
+                     components[2].first, components[2].second,
+                     components[3].first, components[3].second,
+                     components[4].first, components[4].second,
+                     components[5].first, components[5].second);
+  components.erase(std::remove_if(components.begin(), components.end(),
+                                  [](const std::pair<std::string, double>& c) {
+                                    return c.first.empty() || c.second <= 0.;
+                                  }),
+                   components.end());
+  std::sort(components.begin(), components.end());
+
+  double total = 0.;
+  for (const auto& c : components) total += c.second;
+  std::ostringstream key;
+  key.precision(6);
+  for (size_t i = 0; i < components.size(); ++i) {
+    if (i > 0) key << ",";
+    key << components[i].first << ":" << components[i].second / total;
+  }
+  return key.str();
+}
+
+bool GasTableCache::SameComposition(const std::string& key1, const std::string& key2,
+                                    double tolerance) {
+  const auto c1 = ParseCompositionKey(key1);
+  const auto c2 = ParseCompositionKey(key2);
+  if (c1.size() != c2.size()) return false;
+  for (size_t i = 0; i < c1.size(); ++i) {
+    if (c1[i].first != c2[i].first || std::abs(c1[i].second - c2[i].second) > tolerance) return false;
+  }
+  return true;
+}
+
+bool GasTableCache::Check(Garfield::MediumGas& source, const std::string& cacheFile,
+                          const std::string& sourceFile, std::string* report) {
+  std::vector<std::pair<std::string, double> > components(6);
+  source.GetComposition(components[0].first, components[0].second,
+                        components[1].first, components[1].second,
+                        components[2].first, components[2].second,
+                        components[3].first, components[3].second,
+                        components[4].first, components[4].second,
+                        components[5].first, components[5].second);
+  Garfield::MediumGas cached;
+  cached.SetComposition(components[0].first, components[0].second,
+                        components[1].first, components[1].second,
+                        components[2].first, components[2].second,
+                        components[3].first, components[3].second,
+                        components[4].first, components[4].second,
+                        components[5].first, components[5].second);
+  cached.SetTemperature(source.GetTemperature());
+  cached.SetPressure(source.GetPressure());
+  std::string reason;
+  if (!Load(cached, cacheFile, sourceFile, &reason)) {
+    SetReason(report, "cache not loaded (" + reason + ")");
+    return false;
+  }
+
+  std::vector<double> efields, bfields, angles;
+  source.GetFieldGrid(efields, bfields, angles);
+  if (efields.empty()) {
+    SetReason(report, "source has no field grid");
+    return false;
+  }
+
+  // Diferença relativa; o piso absoluto só absorve o exp(-30) que o Garfield++
+  // guarda no lugar de zero no Townsend e no attachment.
+  auto same = [](double a, double b) {
+    return std::abs(a - b) <= 1.e-6 * std::max(std::abs(a), std::abs(b)) + 1.e-12;
+  };
+  constexpr int kMaxReported = 10;
+  int nBad = 0;
+  std::ostringstream text;
+  const std::vector<double> probes = ProbeFields(source, efields);
+  for (double e : probes) {
+    const Transport a = Evaluate(source, e);
+    const Transport b = Evaluate(cached, e);
+    const std::pair<const char*, std::pair<double, double> > quantities[] = {
+        {"velocity", {a.velocity, b.velocity}},
+        {"Townsend", {a.townsend, b.townsend}},
+        {"attachment", {a.attachment, b.attachment}}};
+    for (const auto& q : quantities) {
+      if (same(q.second.first, q.second.second)) continue;
+      if (nBad++ < kMaxReported) {
+        text << q.first << " at E = " << e << " V/cm: gas file " << q.second.first
+             << ", cache " << q.second.second << "\n";
+      }
+    }
+  }
+  if (nBad > 0) {
+    text << nBad << " of " << 3 * probes.size() << " values differ";
+    SetReason(report, text.str());
+    return false;
+  }
+  text << probes.size() << " fields, velocity/Townsend/attachment identical";
+  SetReason(report, text.str());
+  return true;
+}
+
+bool GasTableCache::Write(Garfield::MediumGas& gas, const std::string& cacheFile,
+                          const std::string& sourceFile) {
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+
+  const std::string composition = CompositionKey(gas);
+  if (composition.size() >= kKeyLength) return false;
+  std::strncpy(header.composition, composition.c_str(), kKeyLength - 1);
+  header.temperature = gas.GetTemperature();
+  header.pressure = gas.GetPressure();
+  header.w = gas.GetW();
+  header.fano = gas.GetFanoFactor();
+  if (!SourceStamp(sourceFile, header.sourceMtime, header.sourceSize)) return false;
+
+  std::vector<double> efields, bfields, angles;
+  gas.GetFieldGrid(efields, bfields, angles);
+  header.nE = efields.size();
+  header.nB = bfields.size();
+  header.nA = angles.size();
+  if (efields.empty() || bfields.empty() || angles.empty()) return false;
+
+  // Tabelas presentes, na ordem [ia][ib][ie].
+  const size_t nValues = efields.size() * bfields.size() * angles.size();
+  std::vector<std::pair<uint32_t, std::vector<double> > > present;
+  for (const auto& table : Tables()) {
+    double value = 0.;
+    if (!table.get(gas, 0, 0, 0, value)) continue;
+    std::vector<double> values;
+    values.reserve(nValues);
+    for (size_t k = 0; k < angles.size(); ++k) {
+      for (size_t j = 0; j < bfields.size(); ++j) {
+        for (size_t i = 0; i < efields.size(); ++i) {
+          table.get(gas, i, j, k, value);
+          values.push_back(value);
+        }
+      }
+    }
+    present.emplace_back(table.id, std::move(values));
+  }
+  header.nTables = static_cast<uint32_t>(present.size());
+
+  // Grava num arquivo temporário e renomeia, para que outro processo nunca
+  // mapeie um cache pela metade.
+  const std::string tmpFile = cacheFile + ".tmp." + std::to_string(getpid());
+  FILE* out = std::fopen(tmpFile.c_str(), "wb");
+  if (!out) return false;
+  bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1;
+  ok = ok && std::fwrite(efields.data(), sizeof(double), efields.size(), out) == efields.size();
+  ok = ok && std::fwrite(bfields.data(), sizeof(double), bfields.size(), out) == bfields.size();
+  ok = ok && std::fwrite(angles.data(), sizeof(double), angles.size(), out) == angles.size();
+  for (const auto& table : present) {
+    const uint64_t id = table.first;
+    ok = ok && std::fwrite(&id, sizeof(id), 1, out) == 1;
+    ok = ok && std::fwrite(table.second.data(), sizeof(double), nValues, out) == nValues;
+  }
+  ok = (std::fclose(out) == 0) && ok;
+  if (!ok || std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0) {
+    std::remove(tmpFile.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool GasTableCache::Load(Garfield::MediumGas& gas, const std::string& cacheFile,
+                         const std::string& sourceFile, std::string* reason) {
+  MappedFile file(cacheFile);
+  if (!file.Data()) {
+    SetReason(reason, "cache not found");
+    return false;
+  }
+  if (file.Size() < sizeof(Header)) {
+    SetReason(reason, "truncated header");
+    return false;
+  }
+
+  Header header;
+  std::memcpy(&header, file.Data(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion) {
+    SetReason(reason, "unknown format or version");
+    return false;
+  }
+
+  int64_t mtime = 0;
+  uint64_t size = 0;
+  if (SourceStamp(sourceFile, mtime, size) &&
+      (mtime != header.sourceMtime || size != header.sourceSize)) {
+    SetReason(reason, "source gas file changed");
+    return false;
+  }
+
+  header.composition[kKeyLength - 1] = '\0';
+  const std::string requested = CompositionKey(gas);
+  if (!requested.empty() && requested != header.composition) {
+    SetReason(reason, "composition " + requested + " != " + header.composition);
+    return false;
+  }
+
+  // Temperatura e pressão fazem parte da chave: o chamador já as definiu em gas
+  auto close = [](double a, double b) { return std::abs(a - b) <= 1.e-6 * std::max(std::abs(a), std::abs(b)); };
+  if (!close(header.temperature, gas.GetTemperature()) || !close(header.pressure, gas.GetPressure())) {
+    std::ostringstream text;
+    text << "T/p " << header.temperature << " K, " << header.pressure << " Torr != "
+         << gas.GetTemperature() << " K, " << gas.GetPressure() << " Torr";
+    SetReason(reason, text.str());
+    return false;
+  }
+
+  const size_t nValues = header.nE * header.nB * header.nA;
+  const size_t expected = sizeof(Header) +
+      sizeof(double) * (header.nE + header.nB + header.nA) +
+      header.nTables * (sizeof(uint64_t) + sizeof(double) * nValues);
+  if (nValues == 0 || file.Size() != expected) {
+    SetReason(reason, "inconsistent size");
+    return false;
+  }
+
+  // Leituras com memcpy: o mapeamento não garante alinhamento de double.
+  const char* p = file.Data() + sizeof(Header);
+  auto readArray = [&p](size_t n) {
+    std::vector<double> v(n);
+    std::memcpy(v.data(), p, n * sizeof(double));
+    p += n * sizeof(double);
+    return v;
+  };
+  const std::vector<double> efields = readArray(header.nE);
+  const std::vector<double> bfields = readArray(header.nB);
+  const std::vector<double> angles = readArray(header.nA);
+
+  gas.SetFieldGrid(efields, bfields, angles);
+  if (header.w > 0.) gas.SetW(header.w);
+  if (header.fano > 0.) gas.SetFanoFactor(header.fano);
+
+  for (uint32_t n = 0; n < header.nTables; ++n) {
+    uint64_t id = 0;
+    std::memcpy(&id, p, sizeof(id));
+    p += sizeof(id);
+    const auto it = std::find_if(Tables().begin(), Tables().end(),
+                                 [id](const Table& t) { return t.id == id; });
+    if (it == Tables().end()) {
+      p += nValues * sizeof(double);
+      continue;
+    }
+    size_t index = 0;
+    for (size_t k = 0; k < header.nA; ++k) {
+      for (size_t j = 0; j < header.nB; ++j) {
+        for (size_t i = 0; i < header.nE; ++i) {
+          double value;
+          std::memcpy(&value, p + index * sizeof(double), sizeof(double));
+          it->set(gas, i, j, k, value);
+          ++index;
+        }
+      }
+    }
+    p += nValues * sizeof(double);
+  }
+  return true;
+}
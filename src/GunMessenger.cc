@@ -0,0 +1,125 @@
+#include "GunMessenger.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "Log.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+namespace {
+  G4UIcmdWithADoubleAndUnit* MakeMomentumCommand(const char* path, const char* guidance, G4UImessenger* messenger) {
+    auto* cmd = new G4UIcmdWithADoubleAndUnit(path, messenger);
+    cmd->SetGuidance(guidance);
+    cmd->SetGuidance("Em unidades de energia, lidas como momento (GeV = GeV/c).");
+    cmd->SetParameterName("p", false);
+    cmd->SetRange("p > 0.");
+    cmd->SetUnitCategory("Energy");
+    cmd->SetDefaultUnit("GeV");
+    cmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    cmd->SetToBeBroadcasted(false);
+    return cmd;
+  }
+}
+
+// A configuração do gerador é compartilhada e lida pelas threads a cada
+// evento, então os comandos só precisam rodar no master.
+GunMessenger::GunMessenger() {
+  fGunDir = new G4UIdirectory("/rpc/gun/");
+  fGunDir->SetGuidance("Gerador de múons.");
+
+  fModeCmd = new G4UIcmdWithAString("/rpc/gun/mode", this);
+  fModeCmd->SetGuidance("hemisphere: partícula de energia fixa vindo de uma semiesfera em torno do gap.");
+  fModeCmd->SetGuidance("cosmic: espectro e distribuição angular de múons cósmicos, todos cruzando o gap.");
+  fModeCmd->SetParameterName("mode", false);
+  fModeCmd->SetCandidates("hemisphere cosmic");
+  fModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fModeCmd->SetToBeBroadcasted(false);
+
+  fParticleCmd = new G4UIcmdWithAString("/rpc/gun/particle", this);
+  fParticleCmd->SetGuidance("Partícula do modo hemisphere (nome do Geant4, p. ex. mu-, e-, gamma).");
+  fParticleCmd->SetParameterName("particle", false);
+  fParticleCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fParticleCmd->SetToBeBroadcasted(false);
+
+  fEnergyCmd = new G4UIcmdWithADoubleAndUnit("/rpc/gun/energy", this);
+  fEnergyCmd->SetGuidance("Energia cinética da partícula no modo hemisphere.");
+  fEnergyCmd->SetParameterName("energy", false);
+  fEnergyCmd->SetRange("energy > 0.");
+  fEnergyCmd->SetUnitCategory("Energy");
+  fEnergyCmd->SetDefaultUnit("GeV");
+  fEnergyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEnergyCmd->SetToBeBroadcasted(false);
+
+  fMaxZenithCmd = new G4UIcmdWithADoubleAndUnit("/rpc/gun/maxZenith", this);
+  fMaxZenithCmd->SetGuidance("Ângulo zenital máximo no modo cosmic.");
+  fMaxZenithCmd->SetParameterName("theta", false);
+  fMaxZenithCmd->SetRange("theta > 0. && theta < 90.");
+  fMaxZenithCmd->SetUnitCategory("Angle");
+  fMaxZenithCmd->SetDefaultUnit("deg");
+  fMaxZenithCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fMaxZenithCmd->SetToBeBroadcasted(false);
+
+  fMinMomentumCmd = MakeMomentumCommand("/rpc/gun/minMomentum", "Limite inferior de p cos(theta) no modo cosmic.", this);
+  fMaxMomentumCmd = MakeMomentumCommand("/rpc/gun/maxMomentum", "Limite superior de p cos(theta) no modo cosmic.", this);
+
+  fChargeRatioCmd = new G4UIcmdWithADouble("/rpc/gun/chargeRatio", this);
+  fChargeRatioCmd->SetGuidance("Razão mu+/mu- no modo cosmic.");
+  fChargeRatioCmd->SetParameterName("ratio", false);
+  fChargeRatioCmd->SetRange("ratio >= 0.");
+  fChargeRatioCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fChargeRatioCmd->SetToBeBroadcasted(false);
+}
+
+GunMessenger::~GunMessenger() {
+  delete fChargeRatioCmd;
+  delete fMaxMomentumCmd;
+  delete fMinMomentumCmd;
+  delete fMaxZenithCmd;
+  delete fEnergyCmd;
+  delete fParticleCmd;
+  delete fModeCmd;
+  delete fGunDir;
+}
+
+void GunMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+  if (command == fModeCmd) {
+    PrimaryGeneratorAction::SetMode(newValue == "cosmic" ? PrimaryGeneratorAction::kCosmic
+                                                         : PrimaryGeneratorAction::kHemisphere);
+  } else if (command == fParticleCmd) {
+    PrimaryGeneratorAction::SetParticleName(newValue);
+  } else if (command == fEnergyCmd) {
+    PrimaryGeneratorAction::SetEnergy(fEnergyCmd->GetNewDoubleValue(newValue));
+  } else if (command == fMaxZenithCmd) {
+    PrimaryGeneratorAction::SetMaxZenith(fMaxZenithCmd->GetNewDoubleValue(newValue));
+  } else if (command == fMinMomentumCmd || command == fMaxMomentumCmd) {
+    G4double pMin = PrimaryGeneratorAction::GetMinMomentum();
+    G4double pMax = PrimaryGeneratorAction::GetMaxMomentum();
+    if (command == fMinMomentumCmd) {
+      pMin = fMinMomentumCmd->GetNewDoubleValue(newValue);
+    } else {
+      pMax = fMaxMomentumCmd->GetNewDoubleValue(newValue);
+    }
+    if (pMin >= pMax) {
+      RPC_LOG_ERROR("[LOG] GunMessenger -> Intervalo de momento inválido: "
+                    << pMin / GeV << " GeV/c >= " << pMax / GeV << " GeV/c");
+      return;
+    }
+    PrimaryGeneratorAction::SetMomentumRange(pMin, pMax);
+  } else if (command == fChargeRatioCmd) {
+    PrimaryGeneratorAction::SetChargeRatio(fChargeRatioCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+G4String GunMessenger::GetCurrentValue(G4UIcommand* command) {
+  if (command == fModeCmd) {
+    return PrimaryGeneratorAction::GetMode() == PrimaryGeneratorAction::kCosmic ? "cosmic" : "hemisphere";
+  }
+  if (command == fParticleCmd) return PrimaryGeneratorAction::GetParticleName();
+  if (command == fEnergyCmd) return G4UIcommand::ConvertToString(PrimaryGeneratorAction::GetEnergy(), "GeV");
+  if (command == fMaxZenithCmd) return G4UIcommand::ConvertToString(PrimaryGeneratorAction::GetMaxZenith(), "deg");
+  if (command == fMinMomentumCmd) return G4UIcommand::ConvertToString(PrimaryGeneratorAction::GetMinMomentum(), "GeV");
+  if (command == fMaxMomentumCmd) return G4UIcommand::ConvertToString(PrimaryGeneratorAction::GetMaxMomentum(), "GeV");
+  if (command == fChargeRatioCmd) return G4UIcommand::ConvertToString(PrimaryGeneratorAction::GetChargeRatio());
+  return "";
+}
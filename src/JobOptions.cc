@@ -0,0 +1,123 @@
+#include "JobOptions.hh"
+#include "EventSeeds.hh"
+#include "Log.hh"
+#include <cstdlib>
+#include <iostream>
+
+int JobOptions::fJob = 0;
+int JobOptions::fJobs = 1;
+bool JobOptions::fHasJob = false;
+bool JobOptions::fHasSeed = false;
+unsigned long long JobOptions::fSeed = 0;
+long JobOptions::fSeedOffset = 0;
+bool JobOptions::fHasSeedOffset = false;
+std::string JobOptions::fOutputPrefix;
+
+namespace {
+  void PrintUsage(const char* program) {
+    std::cerr << "Usage: " << program
+              << " [--job i] [--jobs n] [--seed s] [--seed-offset k] [--output prefix] [macro]" << std::endl;
+  }
+
+  // Valor inteiro não negativo da opção; false se inválido
+  bool ParseNumber(const char* text, unsigned long long& value) {
+    if (!text || *text == '\0' || *text == '-') return false;
+    char* end = nullptr;
+    value = std::strtoull(text, &end, 10);
+    return *end == '\0';
+  }
+
+  // Separa a extensão (depois do último '.', fora dos diretórios)
+  void SplitExtension(const std::string& name, std::string& base, std::string& extension) {
+    const auto dot = name.find_last_of('.');
+    const auto slash = name.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+      base = name;
+      extension.clear();
+    } else {
+      base = name.substr(0, dot);
+      extension = name.substr(dot);
+    }
+  }
+}
+
+bool JobOptions::Parse(int argc, char** argv, std::string& macro) {
+  macro.clear();
+  for (int i = 1; i < argc; ++i) {
+    const std::string option = argv[i];
+    if (option.size() < 2 || option.compare(0, 2, "--") != 0) {
+      if (!macro.empty()) {
+        std::cerr << "Only one macro can be given (" << macro << ", " << option << ")" << std::endl;
+        PrintUsage(argv[0]);
+        return false;
+      }
+      macro = option;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << option << std::endl;
+      PrintUsage(argv[0]);
+      return false;
+    }
+    const char* value = argv[++i];
+    unsigned long long number = 0;
+    if (option == "--output") {
+      fOutputPrefix = value;
+    } else if (!ParseNumber(value, number)) {
+      std::cerr << "Invalid value for " << option << ": " << value << std::endl;
+      PrintUsage(argv[0]);
+      return false;
+    } else if (option == "--job") {
+      fJob = static_cast<int>(number);
+      fHasJob = true;
+    } else if (option == "--jobs") {
+      fJobs = static_cast<int>(number);
+    } else if (option == "--seed") {
+      fSeed = number;
+      fHasSeed = true;
+    } else if (option == "--seed-offset") {
+      fSeedOffset = static_cast<long>(number);
+      fHasSeedOffset = true;
+    } else {
+      std::cerr << "Unknown option " << option << std::endl;
+      PrintUsage(argv[0]);
+      return false;
+    }
+  }
+  if (fJobs < 1 || fJob >= fJobs) {
+    std::cerr << "Job index " << fJob << " out of range for " << fJobs << " job(s)" << std::endl;
+    return false;
+  }
+  if (!fHasSeedOffset) fSeedOffset = fJob * kJobEventStride;
+  return true;
+}
+
+void JobOptions::Apply() {
+  if (fHasSeed) EventSeeds::SetSeed(fSeed);
+  EventSeeds::SetEventOffset(fSeedOffset);
+  if (fHasJob || fJobs > 1 || !fOutputPrefix.empty()) {
+    RPC_LOG_INFO("[LOG] JobOptions::Apply -> Job " << fJob << " de " << fJobs << ", eventos a partir do índice "
+                 << fSeedOffset << (fOutputPrefix.empty() ? "" : ", saída com prefixo " + fOutputPrefix));
+  }
+}
+
+std::string JobOptions::JobSuffix() {
+  return fHasJob ? "_job" + std::to_string(fJob) : std::string();
+}
+
+std::string JobOptions::OutputName(const std::string& name) {
+  std::string base, extension;
+  SplitExtension(StripOutputName(name), base, extension);
+  return fOutputPrefix + base + JobSuffix() + extension;
+}
+
+std::string JobOptions::StripOutputName(const std::string& name) {
+  std::string base, extension;
+  SplitExtension(name, base, extension);
+  const std::string suffix = JobSuffix();
+  if (base.size() < fOutputPrefix.size() + suffix.size() || base.compare(0, fOutputPrefix.size(), fOutputPrefix) != 0 ||
+      base.compare(base.size() - suffix.size(), suffix.size(), suffix) != 0) {
+    return name;
+  }
+  return base.substr(fOutputPrefix.size(), base.size() - fOutputPrefix.size() - suffix.size()) + extension;
+}
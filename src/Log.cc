@@ -0,0 +1,31 @@
+#include "Log.hh"
+
+std::atomic<int> Log::fLevel(Log::kInfo);
+
+bool Log::LevelFromString(const std::string& name, Level& level) {
+  if (name == "error") {
+    level = kError;
+  } else if (name == "warning") {
+    level = kWarning;
+  } else if (name == "info") {
+    level = kInfo;
+  } else if (name == "debug") {
+    level = kDebug;
+  } else if (name == "trace") {
+    level = kTrace;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char* Log::LevelName(Level level) {
+  switch (level) {
+    case kError:   return "error";
+    case kWarning: return "warning";
+    case kInfo:    return "info";
+    case kDebug:   return "debug";
+    case kTrace:   return "trace";
+  }
+  return "unknown";
+}
@@ -0,0 +1,39 @@
+#include "LogMessenger.hh"
+#include "Log.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+
+LogMessenger::LogMessenger() {
+  fRpcDir = new G4UIdirectory("/rpc/");
+  fRpcDir->SetGuidance("Controle da simulação da RPC.");
+
+  fLogDir = new G4UIdirectory("/rpc/log/");
+  fLogDir->SetGuidance("Controle das mensagens de log.");
+
+  fLevelCmd = new G4UIcmdWithAString("/rpc/log/level", this);
+  fLevelCmd->SetGuidance("Nível máximo das mensagens [LOG] impressas.");
+  fLevelCmd->SetGuidance("trace imprime uma linha por track; só existe em builds que não são Release.");
+  fLevelCmd->SetParameterName("level", false);
+  fLevelCmd->SetCandidates("error warning info debug trace");
+  fLevelCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  // O nível é global ao processo: basta aplicar no master.
+  fLevelCmd->SetToBeBroadcasted(false);
+}
+
+LogMessenger::~LogMessenger() {
+  delete fLevelCmd;
+  delete fLogDir;
+  delete fRpcDir;
+}
+
+void LogMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+  if (command == fLevelCmd) {
+    Log::Level level;
+    if (Log::LevelFromString(newValue, level)) Log::SetLevel(level);
+  }
+}
+
+G4String LogMessenger::GetCurrentValue(G4UIcommand* command) {
+  if (command == fLevelCmd) return Log::LevelName(Log::GetLevel());
+  return "";
+}
@@ -0,0 +1,109 @@
+#include "OutputMessenger.hh"
+#include "EventOutput.hh"
+#include "Log.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+
+namespace {
+  G4UIcmdWithABool* MakeFlagCommand(const char* path, const char* guidance, G4UImessenger* messenger) {
+    auto* cmd = new G4UIcmdWithABool(path, messenger);
+    cmd->SetGuidance(guidance);
+    cmd->SetGuidance("Vale a partir do primeiro run; depois disso o ntuple já está criado.");
+    cmd->SetParameterName("flag", true);
+    cmd->SetDefaultValue(true);
+    cmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    cmd->SetToBeBroadcasted(false);
+    return cmd;
+  }
+}
+
+// O esquema é compartilhado e lido pelas threads ao criar o ntuple, então os
+// comandos só precisam rodar no master.
+OutputMessenger::OutputMessenger() {
+  fOutputDir = new G4UIdirectory("/rpc/output/");
+  fOutputDir->SetGuidance("Conteúdo e formato do ntuple Garfield.");
+
+  fLayersCmd = MakeFlagCommand("/rpc/output/layers", "Colunas E<camada>/L<camada>: energia e comprimento de track por camada.", this);
+  fGapsCmd = MakeFlagCommand("/rpc/output/gaps", "Colunas Gap*: energia, tamanho da avalanche e elétrons primários por gap.", this);
+  fClustersCmd = MakeFlagCommand("/rpc/output/clusters", "Colunas Cluster*: clusters do Heed aceitos no gap.", this);
+  fAvalanchesCmd = MakeFlagCommand("/rpc/output/avalanches", "Colunas Avalanche*: posição inicial e tamanho por elétron primário.", this);
+  fEndpointsCmd = MakeFlagCommand("/rpc/output/endpoints", "Colunas Endpoint*: ponto final de cada elétron (volumoso no modo full).", this);
+  fPadsCmd = MakeFlagCommand("/rpc/output/pads", "Colunas Pad*: hits dos pads acima do limiar.", this);
+
+  fPrecisionCmd = new G4UIcmdWithAString("/rpc/output/precision", this);
+  fPrecisionCmd->SetGuidance("Tipo das colunas de ponto flutuante.");
+  fPrecisionCmd->SetGuidance("Vale a partir do primeiro run; depois disso o ntuple já está criado.");
+  fPrecisionCmd->SetParameterName("precision", false);
+  fPrecisionCmd->SetCandidates("float double");
+  fPrecisionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fPrecisionCmd->SetToBeBroadcasted(false);
+
+  fCompressionCmd = new G4UIcmdWithAnInteger("/rpc/output/compression", this);
+  fCompressionCmd->SetGuidance("Nível de compressão do arquivo ROOT (0 = sem compressão).");
+  fCompressionCmd->SetParameterName("level", false);
+  fCompressionCmd->SetRange("level >= 0 && level <= 9");
+  fCompressionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fCompressionCmd->SetToBeBroadcasted(false);
+
+  fMergeCmd = MakeFlagCommand("/rpc/output/merge", "Junta os ntuples das threads no arquivo do master ao fim do run.", this);
+}
+
+OutputMessenger::~OutputMessenger() {
+  delete fMergeCmd;
+  delete fCompressionCmd;
+  delete fPrecisionCmd;
+  delete fPadsCmd;
+  delete fEndpointsCmd;
+  delete fAvalanchesCmd;
+  delete fClustersCmd;
+  delete fGapsCmd;
+  delete fLayersCmd;
+  delete fOutputDir;
+}
+
+void OutputMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+  EventOutput::Schema& schema = EventOutput::GetSchema();
+  if (command == fCompressionCmd) {
+    schema.compressionLevel = fCompressionCmd->GetNewIntValue(newValue);
+    return;
+  }
+
+  if (EventOutput::IsSchemaFrozen()) {
+    RPC_LOG_WARNING("[LOG] OutputMessenger -> " << command->GetCommandPath()
+                    << " ignorado: o ntuple já foi criado neste processo.");
+    return;
+  }
+  if (command == fLayersCmd) {
+    schema.layers = fLayersCmd->GetNewBoolValue(newValue);
+  } else if (command == fGapsCmd) {
+    schema.gaps = fGapsCmd->GetNewBoolValue(newValue);
+  } else if (command == fClustersCmd) {
+    schema.clusters = fClustersCmd->GetNewBoolValue(newValue);
+  } else if (command == fAvalanchesCmd) {
+    schema.avalanches = fAvalanchesCmd->GetNewBoolValue(newValue);
+  } else if (command == fEndpointsCmd) {
+    schema.endpoints = fEndpointsCmd->GetNewBoolValue(newValue);
+  } else if (command == fPadsCmd) {
+    schema.pads = fPadsCmd->GetNewBoolValue(newValue);
+  } else if (command == fPrecisionCmd) {
+    schema.useFloat = (newValue == "float");
+  } else if (command == fMergeCmd) {
+    schema.merge = fMergeCmd->GetNewBoolValue(newValue);
+  }
+}
+
+G4String OutputMessenger::GetCurrentValue(G4UIcommand* command) {
+  const EventOutput::Schema& schema = EventOutput::GetSchema();
+  if (command == fLayersCmd) return G4UIcommand::ConvertToString(schema.layers);
+  if (command == fGapsCmd) return G4UIcommand::ConvertToString(schema.gaps);
+  if (command == fClustersCmd) return G4UIcommand::ConvertToString(schema.clusters);
+  if (command == fAvalanchesCmd) return G4UIcommand::ConvertToString(schema.avalanches);
+  if (command == fEndpointsCmd) return G4UIcommand::ConvertToString(schema.endpoints);
+  if (command == fPadsCmd) return G4UIcommand::ConvertToString(schema.pads);
+  if (command == fPrecisionCmd) return schema.useFloat ? "float" : "double";
+  if (command == fCompressionCmd) return G4UIcommand::ConvertToString(schema.compressionLevel);
+  if (command == fMergeCmd) return G4UIcommand::ConvertToString(schema.merge);
+  return "";
+}
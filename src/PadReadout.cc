@@ -0,0 +1,153 @@
+#include "PadReadout.hh"
+#include <algorithm>
+#include <cmath>
+#include "CLHEP/Units/SystemOfUnits.h"
+#include "DetectorParameters.hh"
+#include "WeightingPotentialTable.hh"
+
+bool PadReadout::fEnabled = true;
+double PadReadout::fThreshold = 5.;     // uA
+double PadReadout::fBinWidth = 0.05;    // ns
+int PadReadout::fNumberOfBins = 400;    // janela de 20 ns
+
+namespace {
+  constexpr double kElectronCharge_fC = 1.602176634e-4;
+  // O potencial não é linear ao longo do segmento: mesmo segmentos curtos
+  // são subdivididos.
+  constexpr int kMinSubSteps = 4;
+  constexpr int kMaxSubSteps = 256;
+}
+
+void PadReadout::Configure(const std::vector<WeightingPotentialTable>* tables) {
+  const DetectorParameters* detector = DetectorParameters::Instance();
+  fTables = tables;
+  fTable = tables && !tables->empty() ? &tables->front() : nullptr;
+  fNX = detector->GetNumberOfPadsX();
+  fNZ = detector->GetNumberOfPadsZ();
+  fPitchX = detector->GetPadPitchX() / CLHEP::cm;
+  fPitchZ = detector->GetPadPitchZ() / CLHEP::cm;
+  fFirstX = -0.5 * (fNX - 1) * fPitchX;
+  fFirstZ = -0.5 * (fNZ - 1) * fPitchZ;
+
+  fSlot.assign(static_cast<std::size_t>(detector->GetNumberOfChambers()) * fNX * fNZ, -1);
+  fChamberOffset = 0;
+  fNSignals = 0;
+  Clear();
+}
+
+void PadReadout::SelectGap(int chamber, int gapInChamber) {
+  fChamberOffset = chamber * fNX * fNZ;
+  fTable = fTables && gapInChamber < static_cast<int>(fTables->size())
+               ? &(*fTables)[gapInChamber] : nullptr;
+}
+
+void PadReadout::Clear() {
+  for (std::size_t i = 0; i < fNSignals; ++i) fSlot[fSignals[i].id] = -1;
+  fNSignals = 0;
+  fHasT0 = false;
+  fHits.clear();
+}
+
+PadReadout::PadSignal& PadReadout::Touch(int id) {
+  int& slot = fSlot[id];
+  if (slot < 0) {
+    if (fNSignals == fSignals.size()) fSignals.emplace_back();
+    PadSignal& signal = fSignals[fNSignals];
+    signal.id = id;
+    signal.charge = 0.;
+    signal.current.assign(fNumberOfBins, 0.);
+    slot = static_cast<int>(fNSignals++);
+  }
+  return fSignals[slot];
+}
+
+void PadReadout::AddSegment(double x1, double y1, double z1, double t1,
+                            double x2, double y2, double z2, double t2, double gain) {
+  if (!fTable || !fTable->IsBuilt() || fSlot.empty()) return;
+  const double tMin = std::min(t1, t2);
+  if (!fHasT0) {
+    fT0 = tMin;
+    fHasT0 = true;
+  } else if (tMin < fT0) {
+    MoveOrigin(tMin);
+  }
+
+  // O deslocamento lateral no gap é muito menor que o passo dos pads: os
+  // candidatos são o pad do ponto médio e os seus vizinhos.
+  const double xm = 0.5 * (x1 + x2);
+  const double zm = 0.5 * (z1 + z2);
+  const int jx = static_cast<int>(std::lround((xm - fFirstX) / fPitchX));
+  const int jz = static_cast<int>(std::lround((zm - fFirstZ) / fPitchZ));
+
+  const int nSub = std::min(std::max(static_cast<int>(std::ceil(std::abs(t2 - t1) / fBinWidth)),
+                                     kMinSubSteps), kMaxSubSteps);
+  const double logGain = std::log(std::max(gain, 1.));
+
+  for (int ix = std::max(jx - 1, 0); ix <= std::min(jx + 1, fNX - 1); ++ix) {
+    const double cx = fFirstX + ix * fPitchX;
+    if (std::abs(xm - cx) >= fTable->GetRangeX()) continue;
+    for (int iz = std::max(jz - 1, 0); iz <= std::min(jz + 1, fNZ - 1); ++iz) {
+      const double cz = fFirstZ + iz * fPitchZ;
+      if (std::abs(zm - cz) >= fTable->GetRangeZ()) continue;
+
+      PadSignal* signal = nullptr;
+      double phiPrev = fTable->Evaluate(x1 - cx, y1, z1 - cz);
+      for (int k = 1; k <= nSub; ++k) {
+        const double s = static_cast<double>(k) / nSub;
+        const double phi = fTable->Evaluate(x1 + s * (x2 - x1) - cx, y1 + s * (y2 - y1),
+                                            z1 + s * (z2 - z1) - cz);
+        const double dphi = phi - phiPrev;
+        phiPrev = phi;
+        if (dphi == 0.) continue;
+
+        // Elétrons (carga -e) no meio do subpasso
+        const double sMid = s - 0.5 / nSub;
+        const double dq = -std::exp(logGain * sMid) * dphi * kElectronCharge_fC;
+        if (!signal) signal = &Touch(fChamberOffset + ix * fNZ + iz);
+        signal->charge += dq;
+
+        const double t = t1 + sMid * (t2 - t1);
+        const int bin = static_cast<int>((t - fT0) / fBinWidth);
+        if (bin >= 0 && bin < fNumberOfBins) signal->current[bin] += dq / fBinWidth;
+      }
+    }
+  }
+}
+
+// A origem anda em bins inteiros para manter o alinhamento dos bins já
+// preenchidos; o que passa do fim da janela é descartado.
+void PadReadout::MoveOrigin(double t) {
+  const int shift = static_cast<int>(std::ceil((fT0 - t) / fBinWidth));
+  fT0 -= shift * fBinWidth;
+  for (std::size_t i = 0; i < fNSignals; ++i) {
+    std::vector<double>& current = fSignals[i].current;
+    if (shift >= fNumberOfBins) {
+      std::fill(current.begin(), current.end(), 0.);
+      continue;
+    }
+    std::copy_backward(current.begin(), current.end() - shift, current.end());
+    std::fill(current.begin(), current.begin() + shift, 0.);
+  }
+}
+
+void PadReadout::Finish() {
+  fHits.clear();
+  for (std::size_t i = 0; i < fNSignals; ++i) {
+    const PadSignal& signal = fSignals[i];
+    int nAbove = 0;
+    double leadingEdge = -1.;
+    for (int b = 0; b < fNumberOfBins; ++b) {
+      if (signal.current[b] < fThreshold) continue;
+      if (nAbove++ == 0) {
+        // Cruzamento interpolado entre os centros dos bins b - 1 e b
+        const double previous = b > 0 ? signal.current[b - 1] : 0.;
+        const double frac = (fThreshold - previous) / (signal.current[b] - previous);
+        leadingEdge = fT0 + (b - 0.5 + frac) * fBinWidth;
+      }
+    }
+    if (nAbove == 0) continue;
+    fHits.push_back(PadHit{signal.id, signal.charge, nAbove * fBinWidth, leadingEdge});
+  }
+  std::sort(fHits.begin(), fHits.end(),
+            [](const PadHit& a, const PadHit& b) { return a.id < b.id; });
+}
@@ -1,17 +1,113 @@
 #include "Physics.hh"
+#include "AvalancheTable.hh"
+#include "GasTableCache.hh"
+#include "DetectorParameters.hh"
+#include "WeightingPotentialTable.hh"
+#include "EventSeeds.hh"
+#include "ComponentUniformGap.hh"
+#include "ComponentGapFieldMap.hh"
+#include "EventOutput.hh"
+#include "AllocationCounter.hh"
+#include "Profiler.hh"
 #include "Analysis.hh"
 #include "Garfield/AvalancheMC.hh"
 #include "Garfield/AvalancheMicroscopic.hh"
 #include "G4SystemOfUnits.hh" 
-
-GarfieldPhysics* GarfieldPhysics::fGarfieldPhysics = nullptr;
+#include "G4AutoLock.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "Randomize.hh"
+#include "Log.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+G4ThreadLocal GarfieldPhysics* GarfieldPhysics::fGarfieldPhysics = nullptr;
+
+std::string GarfieldPhysics::fIonizationModel = "Heed";
+MapParticlesEnergy GarfieldPhysics::fMapParticlesEnergyGeant4;
+MapParticlesEnergy GarfieldPhysics::fMapParticlesEnergyGarfield;
+ApplicabilityTable GarfieldPhysics::fGarfieldTable;
+ApplicabilityTable GarfieldPhysics::fGeant4Table;
+bool GarfieldPhysics::fParticleTablesFrozen = false;
+bool GarfieldPhysics::fEnabled = true;
+Garfield::MediumMagboltz* GarfieldPhysics::fMediumMagboltz = nullptr;
+Garfield::ComponentAnalyticField* GarfieldPhysics::fComponentAnalyticField = nullptr;
+ComponentUniformGap* GarfieldPhysics::fUniformGap = nullptr;
+ComponentGapFieldMap* GarfieldPhysics::fFieldMap = nullptr;
+Garfield::Component* GarfieldPhysics::fField = nullptr;
+GarfieldPhysics::FieldModel GarfieldPhysics::fFieldModel = GarfieldPhysics::FieldModel::Uniform;
+double GarfieldPhysics::fFieldMapPitch = 1.;
+int GarfieldPhysics::fFieldMapPlanes = 21;
+bool GarfieldPhysics::createSecondariesInGeant4 = false;
+// O limiar dos elétrons é o mínimo em que o modelo rápido aceita e-: acima
+// dele o delta-elétron volta ao gás como um track novo do Heed.
+double GarfieldPhysics::fSecondaryElectronThreshold = 60.e3;
+double GarfieldPhysics::fSecondaryPhotonThreshold = 10.e3;
+GarfieldPhysics::AvalancheMode GarfieldPhysics::fAvalancheMode = GarfieldPhysics::AvalancheMode::Full;
+AvalancheTable* GarfieldPhysics::fAvalancheTable = nullptr;
+int GarfieldPhysics::fAvalancheTableBins = 20;
+int GarfieldPhysics::fAvalancheTableSamples = 200;
+std::string GarfieldPhysics::fAvalancheTableFile;
+bool GarfieldPhysics::fUseGasCache = true;
+std::string GarfieldPhysics::fGasFile = "rpc_gas_5_5_90.gas";
+std::vector<std::pair<std::string, double>> GarfieldPhysics::fGasComponents = {
+    {"ic4h10", 5.}, {"sf6", 5.}, {"c2h2f4", 90.}};
+int GarfieldPhysics::fGasVersion = 0;
+int GarfieldPhysics::fMediumVersion = -1;
+double GarfieldPhysics::fDriftStep = 1.e-4;
+GarfieldPhysics::SaturationMode GarfieldPhysics::fSaturationMode = GarfieldPhysics::SaturationMode::Off;
+unsigned int GarfieldPhysics::fAvalancheSizeLimit = 1000000;
+double GarfieldPhysics::fEventSizeLimit = 1.e7;
+int GarfieldPhysics::fSampleStride = 10;
+double GarfieldPhysics::fSaturationSize = 1.e6;
+std::atomic<long> GarfieldPhysics::fTruncatedEvents{0};
+int GarfieldPhysics::fFieldVersion = -1;
+int GarfieldPhysics::fFieldGeometryVersion = -1;
+std::vector<WeightingPotentialTable> GarfieldPhysics::fWeightingTables;
+int GarfieldPhysics::fWeightingVersion = -1;
+int GarfieldPhysics::fMaxDriftLines = 5000;
+double GarfieldPhysics::fDriftLineCell = 1. * CLHEP::mm;
 
 namespace {
-  constexpr double kGap   = 0.2; 
-  constexpr double kHalfX = 128.5 / 2.0;
-  constexpr double kHalfZ = 165.0 / 2.0;
-  constexpr double kHV    = 6000.0;
-  constexpr double kEy    = kHV / kGap;
+  constexpr std::size_t kReservedClusters = 256;
+  constexpr std::size_t kReservedElectrons = 1024;
+  constexpr std::size_t kReservedSecondaries = 64;
+  constexpr std::size_t kMaxGasComponents = 6;
+
+  G4Mutex sharedPhysicsMutex = G4MUTEX_INITIALIZER;
+
+  // Nomes do Geant4 que o TrackHeed escreve de outro jeito
+  std::string HeedParticleName(const std::string& name) {
+    if (name == "kaon+") return "K+";
+    if (name == "kaon-") return "K-";
+    if (name == "anti_proton") return "anti-proton";
+    return name;
+  }
+
+  // Condições do gás [K], [Torr]; também entram nas chaves dos caches
+  constexpr double kGasTemperature = 293.15;
+  constexpr double kGasPressure = 760.;
+
+  // Permissividades relativas nominais das camadas entre o gap e os
+  // eletrodos de leitura (não medidas)
+  constexpr double kGlassPermittivity = 7.0;
+  constexpr double kGraphitePermittivity = 12.0;
+  constexpr double kAcrylicPermittivity = 3.0;
+
+  // Gap e tensão no sistema do Garfield++ (cm, V)
+  double GapCm() { return DetectorParameters::Instance()->GetGasGap() / CLHEP::cm; }
+  double HighVoltage() { return DetectorParameters::Instance()->GetHighVoltage() / CLHEP::volt; }
+
+  // Área ativa no referencial local do volume de gás [cm]
+  void SetSensorArea(Garfield::Sensor& sensor) {
+    const DetectorParameters* detector = DetectorParameters::Instance();
+    const double halfX = 0.5 * detector->GetSizeX() / CLHEP::cm;
+    const double halfZ = 0.5 * detector->GetSizeZ() / CLHEP::cm;
+    sensor.SetArea(-halfX, -0.5 * GapCm(), -halfZ,
+                    halfX,  0.5 * GapCm(),  halfZ);
+  }
 }
 
 GarfieldPhysics* GarfieldPhysics::GetInstance() {
@@ -25,10 +121,9 @@ void GarfieldPhysics::Dispose() {
 }
 
 GarfieldPhysics::~GarfieldPhysics() {
-  delete fMediumMagboltz;
-  delete fSensor;
-  delete fComponentAnalyticField;
+  delete fAvalancheMC;
   delete fTrackHeed;
+  delete fSensor;
 
   std::cout << "Deconstructor GarfieldPhysics" << std::endl;
 }
@@ -41,8 +136,19 @@ void GarfieldPhysics::SetIonizationModel(std::string model, bool useDefaults) {
     std::cout << "Using PAIPhot as default model!" << std::endl;
     model = "Heed";
   }
+  if (fParticleTablesFrozen) {
+    RPC_LOG_WARNING("[LOG] GarfieldPhysics::SetIonizationModel -> " << model
+                    << " ignorado: os processos já foram montados com " << fIonizationModel);
+    return;
+  }
   fIonizationModel = model;
 
+  // As faixas padrão de um modelo substituem as do anterior
+  if (useDefaults) {
+    fMapParticlesEnergyGarfield.clear();
+    fMapParticlesEnergyGeant4.clear();
+  }
+
   if (fIonizationModel == "PAIPhot" || fIonizationModel == "PAI") {
     if (useDefaults) {
       this->AddParticleName("gamma", 1e-6, 1e+8, "garfield");
@@ -80,9 +186,14 @@ void GarfieldPhysics::SetIonizationModel(std::string model, bool useDefaults) {
   }
 }
 
-void GarfieldPhysics::AddParticleName(const std::string particleName,
+void GarfieldPhysics::AddParticleName(const std::string& particleName,
                                       double ekin_min_MeV, double ekin_max_MeV,
-                                      std::string program) {
+                                      const std::string& program) {
+  if (fParticleTablesFrozen) {
+    RPC_LOG_WARNING("[LOG] GarfieldPhysics::AddParticleName -> " << particleName
+                    << " ignorada: as tabelas de aplicabilidade já foram montadas.");
+    return;
+  }
   if (ekin_min_MeV >= ekin_max_MeV) {
     std::cout << "Ekin_min=" << ekin_min_MeV
               << " keV is larger than Ekin_max=" << ekin_max_MeV << " keV"
@@ -104,7 +215,7 @@ void GarfieldPhysics::AddParticleName(const std::string particleName,
   }
 }
 
-bool GarfieldPhysics::FindParticleName(std::string name, std::string program) {
+bool GarfieldPhysics::FindParticleName(const std::string& name, const std::string& program) {
   if (program == "garfield") {
     auto it = fMapParticlesEnergyGarfield.find(name);
     if (it != fMapParticlesEnergyGarfield.end()) return true;
@@ -115,8 +226,8 @@ bool GarfieldPhysics::FindParticleName(std::string name, std::string program) {
   return false;
 }
 
-bool GarfieldPhysics::FindParticleNameEnergy(std::string name, double ekin_MeV,
-                                             std::string program) {
+bool GarfieldPhysics::FindParticleNameEnergy(const std::string& name, double ekin_MeV,
+                                             const std::string& program) {
   if (program == "garfield") {
     auto it = fMapParticlesEnergyGarfield.find(name);
     if (it != fMapParticlesEnergyGarfield.end()) {
@@ -137,8 +248,8 @@ bool GarfieldPhysics::FindParticleNameEnergy(std::string name, double ekin_MeV,
   return false;
 }
 
-double GarfieldPhysics::GetMinEnergyMeVParticle(std::string name,
-                                                std::string program) {
+double GarfieldPhysics::GetMinEnergyMeVParticle(const std::string& name,
+                                                const std::string& program) {
   if (program == "garfield") {
     auto it = fMapParticlesEnergyGarfield.find(name);
     if (it != fMapParticlesEnergyGarfield.end()) {
@@ -155,8 +266,8 @@ double GarfieldPhysics::GetMinEnergyMeVParticle(std::string name,
   return -1;
 }
 
-double GarfieldPhysics::GetMaxEnergyMeVParticle(std::string name,
-                                                std::string program) {
+double GarfieldPhysics::GetMaxEnergyMeVParticle(const std::string& name,
+                                                const std::string& program) {
   if (program == "garfield") {
     auto it = fMapParticlesEnergyGarfield.find(name);
     if (it != fMapParticlesEnergyGarfield.end()) {
@@ -173,116 +284,739 @@ double GarfieldPhysics::GetMaxEnergyMeVParticle(std::string name,
   return -1;
 }
 
+int GarfieldPhysics::GetParticleIndex(const G4ParticleDefinition* particle) {
+  return particle->GetInstanceID();
+}
 
-void GarfieldPhysics::InitializePhysics(){
-    G4cout << "[LOG] GarfieldPhysics::InitializePhysics -> Initializing..." << G4endl;
+void GarfieldPhysics::FreezeParticleTables() {
+  G4AutoLock lock(&sharedPhysicsMutex);
+  if (fParticleTablesFrozen) return;
+
+  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+  auto fill = [particleTable](const MapParticlesEnergy& ranges, ApplicabilityTable& table) {
+    table.Clear();
+    for (const auto& item : ranges) {
+      const G4ParticleDefinition* particle = particleTable->FindParticle(item.first);
+      if (!particle) {
+        RPC_LOG_WARNING("[LOG] GarfieldPhysics::FreezeParticleTables -> Partícula desconhecida: " << item.first);
+        continue;
+      }
+      table.Set(GetParticleIndex(particle), item.second.first * CLHEP::MeV,
+                item.second.second * CLHEP::MeV, HeedParticleName(item.first));
+    }
+  };
+  fill(fMapParticlesEnergyGarfield, fGarfieldTable);
+  fill(fMapParticlesEnergyGeant4, fGeant4Table);
+  fParticleTablesFrozen = true;
+
+  RPC_LOG_INFO("[LOG] GarfieldPhysics::FreezeParticleTables -> " << fMapParticlesEnergyGarfield.size()
+               << " partículas para o Heed, " << fMapParticlesEnergyGeant4.size() << " para o "
+               << fIonizationModel);
+}
+
+void GarfieldPhysics::SetAvalancheTableBinning(int nBins, int nSamples) {
+  G4AutoLock lock(&sharedPhysicsMutex);
+  fAvalancheTableBins = nBins;
+  fAvalancheTableSamples = nSamples;
+  delete fAvalancheTable;
+  fAvalancheTable = nullptr;
+}
+
+void GarfieldPhysics::SetAvalancheTableFile(const std::string& fileName) {
+  G4AutoLock lock(&sharedPhysicsMutex);
+  fAvalancheTableFile = fileName;
+  delete fAvalancheTable;
+  fAvalancheTable = nullptr;
+}
+
+void GarfieldPhysics::SetGasFile(const std::string& fileName) {
+  G4AutoLock lock(&sharedPhysicsMutex);
+  if (fileName == fGasFile) return;
+  fGasFile = fileName;
+  ++fGasVersion;
+}
+
+bool GarfieldPhysics::SetGasComposition(const std::string& composition) {
+  std::vector<std::pair<std::string, double>> components;
+  std::string text = composition;
+  text.erase(std::remove(text.begin(), text.end(), '"'), text.end());
+  std::istringstream input(text);
+  std::string gas;
+  while (input >> gas) {
+    double fraction = 0.;
+    if (!(input >> fraction) || fraction <= 0.) {
+      RPC_LOG_ERROR("[LOG] GarfieldPhysics::SetGasComposition -> Fração inválida para " << gas
+                    << " em \"" << composition << "\"");
+      return false;
+    }
+    components.emplace_back(gas, fraction);
+  }
+  if (components.empty() || components.size() > kMaxGasComponents) {
+    RPC_LOG_ERROR("[LOG] GarfieldPhysics::SetGasComposition -> Esperados de 1 a " << kMaxGasComponents
+                  << " pares <gás> <fração>, recebido \"" << composition << "\"");
+    return false;
+  }
+
+  G4AutoLock lock(&sharedPhysicsMutex);
+  if (components == fGasComponents) return true;
+  fGasComponents = components;
+  ++fGasVersion;
+  return true;
+}
+
+std::string GarfieldPhysics::GetGasComposition() {
+  std::ostringstream text;
+  for (std::size_t i = 0; i < fGasComponents.size(); ++i) {
+    if (i > 0) text << ' ';
+    text << fGasComponents[i].first << ' ' << fGasComponents[i].second;
+  }
+  return text.str();
+}
+
+void GarfieldPhysics::SetDriftStep(double step) {
+  G4AutoLock lock(&sharedPhysicsMutex);
+  if (step == fDriftStep) return;
+  fDriftStep = step;
+  delete fAvalancheTable;
+  fAvalancheTable = nullptr;
+}
+
+void GarfieldPhysics::InitializeSharedPhysics(){
+    G4AutoLock lock(&sharedPhysicsMutex);
+    if (!fMediumMagboltz || fMediumVersion != fGasVersion) {
+        BuildMedium();
+    }
+
+    if (!fField || fFieldVersion != DetectorParameters::Instance()->GetFieldVersion()) {
+        BuildField();
+    }
+
+    if (PadReadout::IsEnabled() &&
+        (fWeightingTables.empty() || fWeightingVersion != DetectorParameters::Instance()->GetVersion())) {
+        BuildWeightingTable();
+    }
+
+    if (fAvalancheMode == AvalancheMode::Parameterized && !fAvalancheTable) {
+        BuildAvalancheTable();
+    }
+}
+
+// Chamado com sharedPhysicsMutex travado, antes de os workers começarem o run.
+// Se só a tensão mudou (mesma versão da geometria, que inclui gap e modelo),
+// os componentes são atualizados no lugar: os Sensors das threads guardam o
+// ponteiro e continuam válidos, sem refazer TrackHeed e AvalancheMC. Senão os
+// componentes são refeitos e os Sensors também, em InitializePhysics().
+void GarfieldPhysics::BuildField() {
+    const DetectorParameters* detector = DetectorParameters::Instance();
+    const double gap = GapCm();
+    const double hv = HighVoltage();
+
+    const bool inPlace = fField && fFieldGeometryVersion == detector->GetVersion();
+    if (!inPlace) {
+        delete fFieldMap;
+        delete fUniformGap;
+        delete fComponentAnalyticField;
+        fFieldMap = nullptr;
+        fUniformGap = nullptr;
+        fComponentAnalyticField = nullptr;
+    }
 
+    if (fFieldModel == FieldModel::Uniform) {
+        if (!fUniformGap) {
+            fUniformGap = new ComponentUniformGap();
+            fUniformGap->SetMedium(fMediumMagboltz);
+        }
+        fUniformGap->SetPlates(ParallelPlates{-0.5 * gap, +0.5 * gap, 0., -hv});
+        fField = fUniformGap;
+    } else {
+        if (fComponentAnalyticField) {
+            fComponentAnalyticField->Clear();
+        } else {
+            fComponentAnalyticField = new Garfield::ComponentAnalyticField();
+        }
+        fComponentAnalyticField->SetMedium(fMediumMagboltz);
+        fComponentAnalyticField->AddPlaneY(-0.5 * gap,  0., "anode");
+        fComponentAnalyticField->AddPlaneY(+0.5 * gap, -hv, "cathode");
+
+        // O ComponentAnalyticField monta a célula na primeira avaliação do campo.
+        // Forçamos isso aqui, ainda em uma única thread, para que os workers só
+        // façam leituras depois.
+        double ex = 0., ey = 0., ez = 0.;
+        Garfield::Medium* medium = nullptr;
+        int status = 0;
+        fComponentAnalyticField->ElectricField(0., 0., 0., ex, ey, ez, medium, status);
+        fField = fComponentAnalyticField;
+    }
+
+    if (fFieldModel == FieldModel::Map) {
+        const double halfX = 0.5 * detector->GetSizeX() / CLHEP::cm;
+        const double halfZ = 0.5 * detector->GetSizeZ() / CLHEP::cm;
+        const int nx = 1 + static_cast<int>(std::ceil(2 * halfX / fFieldMapPitch));
+        const int nz = 1 + static_cast<int>(std::ceil(2 * halfZ / fFieldMapPitch));
+        if (!fFieldMap) {
+            fFieldMap = new ComponentGapFieldMap();
+            fFieldMap->SetMedium(fMediumMagboltz);
+        }
+        fFieldMap->Build(*fComponentAnalyticField, -halfX, -0.5 * gap, -halfZ,
+                         halfX, 0.5 * gap, halfZ, nx, fFieldMapPlanes, nz);
+        fField = fFieldMap;
+        // Só a fonte do mapa; o drift não volta a consultá-lo
+        delete fComponentAnalyticField;
+        fComponentAnalyticField = nullptr;
+        RPC_LOG_INFO("[LOG] GarfieldPhysics::BuildField -> Mapa do campo com " << nx << " x "
+                     << fFieldMapPlanes << " x " << nz << " nós ("
+                     << fFieldMap->GetMemoryUsage() / (1024. * 1024.) << " MB)");
+    }
+
+    // A tabela de avalanche depende do gap e da tensão
+    delete fAvalancheTable;
+    fAvalancheTable = nullptr;
+    fFieldVersion = detector->GetFieldVersion();
+    fFieldGeometryVersion = detector->GetVersion();
+
+    RPC_LOG_INFO("[LOG] GarfieldPhysics::BuildField -> Gap: " << gap << " cm, HV: " << hv
+                 << " V, E-Field (Ey): " << hv / gap << " V/cm" << (inPlace ? " (só a tensão)" : ""));
+}
+
+void GarfieldPhysics::SetFieldModel(FieldModel model) {
+    if (model == fFieldModel) return;
+    fFieldModel = model;
+    DetectorParameters::Instance()->FieldChanged();
+}
+
+void GarfieldPhysics::SetFieldMapBinning(double pitch, int nPlanes) {
+    if (pitch == fFieldMapPitch && nPlanes == fFieldMapPlanes) return;
+    fFieldMapPitch = pitch;
+    fFieldMapPlanes = nPlanes;
+    if (fFieldModel == FieldModel::Map) DetectorParameters::Instance()->FieldChanged();
+}
+
+// Um único pad de referência por gap da câmara; os demais são obtidos por
+// translação. Os pads ficam em cima (vidro, grafite, acrílico) e a terra é o
+// alumínio de baixo (vidro, grafite, acrílico); entre eles ficam também os
+// outros gaps da câmara e os seus vidros.
+void GarfieldPhysics::BuildWeightingTable() {
+    const DetectorParameters* detector = DetectorParameters::Instance();
+    const double halfX = 0.5 * detector->GetPadSizeX() / CLHEP::cm;
+    const double halfZ = 0.5 * detector->GetPadSizeZ() / CLHEP::cm;
+    const double gap = GapCm();
+    const double glass = detector->GetGlassThickness() / CLHEP::cm / kGlassPermittivity;
+    const double electrode = glass +
+                             detector->GetGraphiteThickness() / CLHEP::cm / kGraphitePermittivity +
+                             detector->GetAcrylicThickness() / CLHEP::cm / kAcrylicPermittivity;
+    const int nGaps = detector->GetGapsPerChamber();
+
+    fWeightingTables.resize(nGaps);
+    for (int i = 0; i < nGaps; ++i) {
+        const double groundDistance = electrode + i * (gap + glass);
+        const double padDistance = electrode + (nGaps - 1 - i) * (gap + glass);
+        fWeightingTables[i].Build(gap, groundDistance, padDistance, halfX, halfZ);
+    }
+    fWeightingVersion = detector->GetVersion();
+
+    RPC_LOG_INFO("[LOG] GarfieldPhysics::BuildWeightingTable -> Potencial de ponderação tabelado para pad de "
+                 << 2 * halfX << " x " << 2 * halfZ << " cm, " << nGaps
+                 << " gap(s) por câmara, distância efetiva gap-pads " << electrode
+                 << " cm (carga não calibrada)");
+}
+
+// Chamado com sharedPhysicsMutex travado. O campo, se já existe, passa a usar
+// o meio novo sem ser refeito; os objetos das threads são refeitos em
+// InitializePhysics() pela versão do meio.
+void GarfieldPhysics::BuildMedium() {
+    RPC_LOG_INFO("[LOG] GarfieldPhysics::BuildMedium -> Initializing medium " << GetGasComposition()
+                 << " from " << fGasFile << "...");
+
+    std::string gases[kMaxGasComponents];
+    double fractions[kMaxGasComponents] = {};
+    for (std::size_t i = 0; i < fGasComponents.size(); ++i) {
+        gases[i] = fGasComponents[i].first;
+        fractions[i] = fGasComponents[i].second;
+    }
+
+    Garfield::MediumMagboltz* previous = fMediumMagboltz;
     fMediumMagboltz = new Garfield::MediumMagboltz();
-    fMediumMagboltz->SetComposition("ic4h10", 5., "sf6", 5., "c2h2f4", 90.);
-    fMediumMagboltz->SetTemperature(293.15);
-    fMediumMagboltz->SetPressure(760.);
+    fMediumMagboltz->SetComposition(gases[0], fractions[0], gases[1], fractions[1], gases[2], fractions[2],
+                                    gases[3], fractions[3], gases[4], fractions[4], gases[5], fractions[5]);
+    fMediumMagboltz->SetTemperature(kGasTemperature);
+    fMediumMagboltz->SetPressure(kGasPressure);
     fMediumMagboltz->EnableDrift();
-    fMediumMagboltz->Initialise(true);
-    
-    if (!fMediumMagboltz->LoadGasFile("rpc_gas_5_5_90.gas")) {
-        G4cout << "[LOG] GarfieldPhysics::InitializePhysics -> ERRO: Arquivo .gas não encontrado!" << G4endl;
-    } else {
-        G4cout << "[LOG] GarfieldPhysics::InitializePhysics -> Arquivo .gas carregado com sucesso." << G4endl;
+    // Só as tabelas (cache ou .gas): o AvalancheMC e o Heed não precisam das
+    // seções de choque do Magboltz (Initialise).
+    LoadGasTable();
+
+    if (fComponentAnalyticField) fComponentAnalyticField->SetMedium(fMediumMagboltz);
+    if (fUniformGap) fUniformGap->SetMedium(fMediumMagboltz);
+    if (fFieldMap) fFieldMap->SetMedium(fMediumMagboltz);
+    delete previous;
+
+    // A tabela de avalanche depende do gás
+    delete fAvalancheTable;
+    fAvalancheTable = nullptr;
+    fMediumVersion = fGasVersion;
+}
+
+void GarfieldPhysics::LoadGasTable() {
+    const std::string cacheFile = GasTableCache::DefaultCacheName(fGasFile);
+    if (fUseGasCache) {
+        std::string reason;
+        if (GasTableCache::Load(*fMediumMagboltz, cacheFile, fGasFile, &reason)) {
+            RPC_LOG_INFO("[LOG] GarfieldPhysics::LoadGasTable -> Tabela do gás lida do cache " << cacheFile);
+            return;
+        }
+        RPC_LOG_INFO("[LOG] GarfieldPhysics::LoadGasTable -> Cache " << cacheFile << " não usado (" << reason << ")");
     }
 
+    // O LoadGasFile troca a composição do meio pela do arquivo
+    const std::string requested = GasTableCache::CompositionKey(*fMediumMagboltz);
+    if (!fMediumMagboltz->LoadGasFile(fGasFile)) {
+        RPC_LOG_ERROR("[LOG] GarfieldPhysics::LoadGasTable -> ERRO: Arquivo .gas " << fGasFile << " não encontrado!");
+        return;
+    }
+    const std::string loaded = GasTableCache::CompositionKey(*fMediumMagboltz);
+    if (!GasTableCache::SameComposition(requested, loaded)) {
+        RPC_LOG_ERROR("[LOG] GarfieldPhysics::LoadGasTable -> ERRO: " << fGasFile << " é de " << loaded
+                      << ", não da composição pedida " << requested
+                      << " (/garfield/gas/composition); a simulação usa a do arquivo.");
+        return;
+    }
+    RPC_LOG_INFO("[LOG] GarfieldPhysics::LoadGasTable -> Arquivo .gas carregado com sucesso.");
+
+    if (fUseGasCache && GasTableCache::Write(*fMediumMagboltz, cacheFile, fGasFile)) {
+        // Limiares e interpolação não vão para o cache (ver GasTableCache)
+        std::string report;
+        if (GasTableCache::Check(*fMediumMagboltz, cacheFile, fGasFile, &report)) {
+            RPC_LOG_INFO("[LOG] GarfieldPhysics::LoadGasTable -> Cache gravado em " << cacheFile);
+        } else {
+            std::remove(cacheFile.c_str());
+            RPC_LOG_WARNING("[LOG] GarfieldPhysics::LoadGasTable -> Cache " << cacheFile
+                            << " não reproduz o .gas e foi apagado:" << G4endl << report);
+        }
+    }
+}
 
-    fComponentAnalyticField = new Garfield::ComponentAnalyticField();
-    fComponentAnalyticField->SetMedium(fMediumMagboltz);
-    fComponentAnalyticField->AddPlaneY(-0.5 * kGap,    0., "anode");
-    fComponentAnalyticField->AddPlaneY(+0.5 * kGap, -kHV, "cathode");
-    
-    G4cout << "[LOG] GarfieldPhysics::InitializePhysics -> E-Field (Ey): " << kEy << " V/cm" << G4endl;
+void GarfieldPhysics::BuildAvalancheTable() {
+    AvalancheTable::Key key;
+    key.gap = GapCm();
+    key.hv = HighVoltage();
+    key.stepSize = fDriftStep;
+    key.temperature = kGasTemperature;
+    key.pressure = kGasPressure;
+    key.gasFile = fGasFile;
+    // A do meio, que é a do .gas carregado mesmo que difira da pedida
+    key.composition = GasTableCache::CompositionKey(*fMediumMagboltz);
+    std::ostringstream fieldModel;
+    switch (fFieldModel) {
+        case FieldModel::Analytic: fieldModel << "analytic"; break;
+        case FieldModel::Uniform: fieldModel << "uniform"; break;
+        case FieldModel::Map: fieldModel << "map " << fFieldMapPitch << " " << fFieldMapPlanes; break;
+    }
+    key.fieldModel = fieldModel.str();
 
+    auto* table = new AvalancheTable();
+    if (!fAvalancheTableFile.empty() && table->Load(fAvalancheTableFile, key)) {
+        RPC_LOG_INFO("[LOG] GarfieldPhysics::BuildAvalancheTable -> Tabela lida de " << fAvalancheTableFile);
+        fAvalancheTable = table;
+        return;
+    }
+    if (!fAvalancheTableFile.empty()) {
+        RPC_LOG_INFO("[LOG] GarfieldPhysics::BuildAvalancheTable -> " << fAvalancheTableFile
+                     << " ausente ou de outra configuração (gap, tensão, passo, gás ou campo)");
+    }
+
+    RPC_LOG_INFO("[LOG] GarfieldPhysics::BuildAvalancheTable -> Amostrando " << fAvalancheTableSamples
+                 << " avalanches em " << fAvalancheTableBins << " fatias do gap...");
+    Garfield::Sensor sensor;
+    sensor.AddComponent(fField);
+    SetSensorArea(sensor);
+    Garfield::AvalancheMC avalanche(&sensor);
+    avalanche.SetDistanceSteps(fDriftStep);
+    EventSeeds::SeedTableSampling();
+    table->Build(avalanche, key, -0.5 * key.gap, 0.5 * key.gap,
+                 fAvalancheTableBins, fAvalancheTableSamples);
+
+    if (!fAvalancheTableFile.empty() && table->Save(fAvalancheTableFile)) {
+        RPC_LOG_INFO("[LOG] GarfieldPhysics::BuildAvalancheTable -> Tabela gravada em " << fAvalancheTableFile);
+    }
+    fAvalancheTable = table;
+}
+
+void GarfieldPhysics::InitializePhysics(){
+    InitializeSharedPhysics();
+    BookTrackPositionHistogram();
+    fDriftLines.Configure(static_cast<std::size_t>(fMaxDriftLines), fDriftLineCell);
+    ReserveBuffers();
+    fPadReadout.Configure(PadReadout::IsEnabled() ? &fWeightingTables : nullptr);
+
+    const DetectorParameters* detector = DetectorParameters::Instance();
+    fGapsPerChamber = detector->GetGapsPerChamber();
+    fGapResults.assign(detector->GetNumberOfGaps(), GapResult());
+    if (fSensor && fSensorVersion == detector->GetVersion() && fSensorMediumVersion == fMediumVersion) {
+        ConfigureTransport();
+        return;
+    }
+
+    RPC_LOG_INFO("[LOG] GarfieldPhysics::InitializePhysics -> Initializing thread-local transport...");
+
+    // Na primeira vez e a cada mudança de geometria/tensão/gás: o Sensor
+    // aponta para o campo compartilhado, que pode ter sido refeito, e o
+    // TrackHeed guarda as propriedades do meio.
+    delete fAvalancheMC;
+    delete fTrackHeed;
+    delete fSensor;
 
     fSensor = new Garfield::Sensor();
-    fSensor->AddComponent(fComponentAnalyticField);
-    fSensor->SetArea(-kHalfX, -0.5 * kGap, -kHalfZ,
-                      kHalfX,  0.5 * kGap,  kHalfZ);
-    G4cout << "[LOG] GarfieldPhysics::InitializePhysics -> Sensor Area Set." << G4endl;
+    fSensor->AddComponent(fField);
+    SetSensorArea(*fSensor);
+    RPC_LOG_INFO("[LOG] GarfieldPhysics::InitializePhysics -> Sensor Area Set.");
 
     fTrackHeed = new Garfield::TrackHeed(fSensor);
-    fTrackHeed->EnableDeltaElectronTransport();
-    G4cout << "[LOG] GarfieldPhysics::InitializePhysics -> TrackHeed enabled. Initialization finished." << G4endl;
+
+    fAvalancheMC = new Garfield::AvalancheMC(fSensor);
+
+    fAcceptance = AcceptanceBox{-0.5 * GapCm(), 0.5 * GapCm(),
+                                0.5 * detector->GetSizeX() / CLHEP::cm,
+                                0.5 * detector->GetSizeZ() / CLHEP::cm};
+    fSensorVersion = detector->GetVersion();
+    fSensorMediumVersion = fMediumVersion;
+    ConfigureTransport();
+    RPC_LOG_INFO("[LOG] GarfieldPhysics::InitializePhysics -> TrackHeed enabled. Initialization finished.");
+}
+
+// Configuração do run que não depende da geometria. O limite por avalanche
+// vai para o AvalancheMC: ele para de seguir
+// elétrons quando a avalanche chega ao limite, o que limita o tempo de um
+// evento tipo streamer.
+void GarfieldPhysics::ConfigureTransport() {
+    const bool limited = fSaturationMode != SaturationMode::Off;
+
+    // Secundários: o Heed entrega os delta-elétrons e os fótons de
+    // fluorescência sem transportá-los (ver AddClusterElectrons)
+    if (createSecondariesInGeant4) {
+        fTrackHeed->DisableDeltaElectronTransport();
+        fTrackHeed->EnablePhotonReabsorption(false);
+    } else {
+        fTrackHeed->EnableDeltaElectronTransport();
+        fTrackHeed->EnablePhotonReabsorption(true);
+    }
+
+    fAvalancheMC->SetDistanceSteps(fDriftStep);
+    if (!limited) {
+        fAvalancheMC->DisableAvalancheSizeLimit();
+        return;
+    }
+    fAvalancheMC->EnableAvalancheSizeLimit(fAvalancheSizeLimit);
+    RPC_LOG_DEBUG("[LOG] GarfieldPhysics::ConfigureTransport -> Avalanche limitada a "
+                  << fAvalancheSizeLimit << " elétrons, evento a " << fEventSizeLimit
+                  << " (amostragem 1/" << fSampleStride << " acima disso)");
+}
+
+// Tamanho efetivo de uma avalanche de n elétrons; marca o evento como
+// truncado se ela parou no limite.
+double GarfieldPhysics::SaturatedSize(double size) {
+    if (fSaturationMode == SaturationMode::Off) return size;
+    if (size >= fAvalancheSizeLimit) {
+        size = fAvalancheSizeLimit;
+        fEventTruncated = true;
+    }
+    if (fSaturationMode == SaturationMode::SpaceCharge && fSaturationSize > 0.) {
+        size = fSaturationSize * -std::expm1(-size / fSaturationSize);
+    }
+    return size;
 }
 
-double GarfieldPhysics::GetEnergyDeposit_MeV() {
-  return fEnergyDeposit / 1.e6;
+// Capacidade inicial dos buffers da thread, para que mesmo os primeiros
+// eventos típicos (um múon, algumas dezenas de clusters) não cresçam os
+// vetores no meio do transporte. Eventos maiores ainda crescem uma vez.
+void GarfieldPhysics::ReserveBuffers() {
+    fClusterBatch.Reserve(kReservedClusters);
+    fElectronBatch.Reserve(kReservedElectrons);
+    fSecondaryParticles.reserve(kReservedSecondaries);
 }
 
-void GarfieldPhysics::DoIt(std::string particleName, double ekin_MeV,
+void GarfieldPhysics::BookTrackPositionHistogram() {
+    if (fTrackPosition.IsBooked()) return;
+    G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+    if (!analysisManager->GetH3(1, false)) return;
+    fTrackPosition.Book();
+    fTrackPosition.Reserve(kReservedElectrons);
+}
+
+void GarfieldPhysics::FlushHistograms() {
+    if (!fTrackPosition.IsBooked()) return;
+    AllocationCounter::External external;
+    G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+    fTrackPosition.Flush([analysisManager](double x, double y, double z, double weight) {
+        analysisManager->FillH3(1, x, y, z, weight);
+    });
+}
+
+double GarfieldPhysics::GetEventEnergyDeposit_MeV() const {
+  double energy = 0.;
+  for (const GapResult& result : fGapResults) energy += result.energy;
+  return energy / 1.e6;
+}
+
+// Razão das somas do evento, não média dos ganhos de cada track
+double GarfieldPhysics::GetEventGain() const {
+  double size = 0.;
+  int electrons = 0;
+  for (const GapResult& result : fGapResults) {
+    size += result.avalancheSize;
+    electrons += result.electrons;
+  }
+  return electrons > 0 ? size / electrons : 0.;
+}
+
+void GarfieldPhysics::DoIt(const std::string& particleName, double ekin_MeV,
                            double time, double x_cm, double y_cm, double z_cm,
-                           double dx, double dy, double dz) {
-  G4cout << "\n[LOG] GarfieldPhysics::DoIt -> Simulating track in Garfield++" << G4endl;
-  G4cout << "    -> Particle: " << particleName << " at (" << x_cm << ", " << y_cm << ", " << z_cm << ") cm" << G4endl;
+                           double dx, double dy, double dz, int gap) {
+  AllocationCounter::Tracked tracked;
+  RPC_LOG_TRACE("[LOG] GarfieldPhysics::DoIt -> Simulating track in Garfield++" << G4endl
+                << "    -> Particle: " << particleName << " at (" << x_cm << ", " << y_cm << ", " << z_cm
+                << ") cm, gap " << gap);
+
+  if (gap < 0 || gap >= static_cast<int>(fGapResults.size())) {
+    RPC_LOG_WARNING("[LOG] GarfieldPhysics::DoIt -> Gap " << gap << " fora da pilha; usando o gap 0");
+    gap = 0;
+  }
+  fGap = gap;
+  fGapCenter = DetectorParameters::Instance()->GetGapCenter(gap);
+  fPadReadout.SelectGap(gap / fGapsPerChamber, gap % fGapsPerChamber);
 
-  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
   fEnergyDeposit = 0;
   fSecondaryParticles.clear();
+  fSecondaryEnergy = 0;
+  fPrimaryAbsorbed = false;
   fAvalancheSize = 0;
   nsum = 0;
-  fDriftLines.clear(); // Limpa as linhas de drift do evento anterior
-
-  Garfield::AvalancheMC drift(fSensor);
-  drift.SetDistanceSteps(1.e-4);
 
-  constexpr double yMin = -0.5 * kGap;
-  constexpr double yMax = +0.5 * kGap;
+  const AcceptanceBox& box = fAcceptance;
   double eKin_eV = ekin_MeV * 1e+6;
 
-  if (particleName == "gamma") {
-    Garfield::TrackHeed::Cluster cl = fTrackHeed->TransportPhoton(x_cm, y_cm, z_cm, time, eKin_eV, dx, dy, dz);
-    for (const auto& electron : cl.electrons) {
-      if (electron.y < yMin || electron.y > yMax || std::abs(electron.x) > kHalfX || std::abs(electron.z) > kHalfZ) continue;
-      nsum++;
-      fEnergyDeposit += fTrackHeed->GetW();
-      drift.DriftElectron(electron.x, electron.y, electron.z, electron.t);
-    }
-  } else {
-    fTrackHeed->SetParticle(particleName);
-    fTrackHeed->SetKineticEnergy(eKin_eV);
-    fTrackHeed->NewTrack(x_cm, y_cm, z_cm, time, dx, dy, dz);
-
-    for (const auto& cluster : fTrackHeed->GetClusters()) {
-      if (cluster.y < yMin || cluster.y > yMax || std::abs(cluster.x) > kHalfX || std::abs(cluster.z) > kHalfZ) continue;
-      
-      nsum += cluster.electrons.size();
-      fEnergyDeposit += cluster.energy;
-      
-      for (const auto& electron : cluster.electrons) {
-        if (electron.y < yMin || electron.y > yMax || std::abs(electron.x) > kHalfX || std::abs(electron.z) > kHalfZ) continue;
-
-        analysisManager->FillH3(1, electron.y * 10, electron.x * 10, electron.z * 10);
-        drift.DriftElectron(electron.x, electron.y, electron.z, electron.t);
+  // Gerador e meio do Garfield++ são do processo: o Heed e o AvalancheMC
+  // rodam com a trava, uma thread de cada vez (ver o comentário da classe).
+  G4AutoLock garfieldLock(&EventSeeds::GarfieldMutex());
+  // Fluxo próprio do track: não depende do que as outras threads sortearam
+  EventSeeds::SeedGarfieldTrack();
+
+  // Os elétrons aceitos são reunidos em fElectronBatch (estrutura de arrays)
+  // e o corte geométrico é feito de uma vez, sem desvios, antes do transporte.
+  fElectronBatch.Clear();
+  std::size_t nClusters = 0;
+  {
+    // Fase "heed" do Profiler: clusters do Heed e corte de aceitação
+    Profiler::Scope heedScope(Profiler::kHeed);
+    if (particleName == "gamma") {
+      Garfield::TrackHeed::Cluster cl;
+      {
+        AllocationCounter::External external;
+        cl = fTrackHeed->TransportPhoton(x_cm, y_cm, z_cm, time, eKin_eV, dx, dy, dz);
+      }
+      AddClusterElectrons(cl);
+      const std::size_t nAccepted = fElectronBatch.Accept(box);
+      nsum += nAccepted;
+      fEnergyDeposit += nAccepted * fTrackHeed->GetW();
+      // Fóton absorbido: o track termina aqui e a energia que não voltou ao
+      // Geant4 como secundário fica no gás
+      fPrimaryAbsorbed = !cl.electrons.empty() || !cl.photons.empty();
+      if (fPrimaryAbsorbed) {
+        fEnergyDeposit = std::max(0., eKin_eV - fSecondaryEnergy);
+      }
+      if (nAccepted > 0) ++nClusters;
+      if (fEventOutput && nAccepted > 0) {
+        fEventOutput->AddCluster(fGap, cl.x, cl.y, cl.z, cl.t, nAccepted * fTrackHeed->GetW(),
+                                 static_cast<int>(nAccepted));
+      }
+    } else {
+      {
+        AllocationCounter::External external;
+        fTrackHeed->SetParticle(particleName);
+        fTrackHeed->SetKineticEnergy(eKin_eV);
+        fTrackHeed->NewTrack(x_cm, y_cm, z_cm, time, dx, dy, dz);
+      }
+
+      const auto& clusters = fTrackHeed->GetClusters();
+      fClusterBatch.Clear();
+      for (const auto& cluster : clusters) {
+        fClusterBatch.Add(cluster.x, cluster.y, cluster.z, cluster.t);
+      }
+      fClusterBatch.Accept(box);
+
+      for (std::size_t i = 0; i < clusters.size(); ++i) {
+        if (!fClusterBatch.IsAccepted(i)) continue;
+        const auto& cluster = clusters[i];
+        ++nClusters;
+        // A energia dos secundários devolvidos ao Geant4 não fica no cluster
+        const double secondaryEnergy = fSecondaryEnergy;
+        const std::size_t nElectrons = AddClusterElectrons(cluster);
+        const double energy = cluster.energy - (fSecondaryEnergy - secondaryEnergy);
+        nsum += nElectrons;
+        fEnergyDeposit += energy;
+        if (fEventOutput) {
+          fEventOutput->AddCluster(fGap, cluster.x, cluster.y, cluster.z, cluster.t, energy,
+                                   static_cast<int>(nElectrons));
+        }
+      }
+      fElectronBatch.Accept(box);
+
+      // H3 em mm, eixos (y, x, z); repassado ao G4AnalysisManager em FlushHistograms()
+      if (fTrackPosition.IsBooked()) {
+        fTrackPosition.FillBatch(fElectronBatch.YData(), fElectronBatch.XData(), fElectronBatch.ZData(),
+                                 fElectronBatch.AcceptedData(), fElectronBatch.Size(), 10.);
       }
     }
   }
+  Profiler::Count(Profiler::kClusters, nClusters);
+  Profiler::Count(Profiler::kElectrons, nsum);
+  // A tabela parametrizada sorteia com o gerador do Geant4 da thread
+  if (fAvalancheMode == AvalancheMode::Parameterized && fAvalancheTable) garfieldLock.unlock();
+
+  // Passado o limite do evento, os primários restantes são amostrados: um a
+  // cada fSampleStride, com peso fSampleStride.
+  const bool limited = fSaturationMode != SaturationMode::Off;
+  std::size_t nSkipped = 0;
+  for (std::size_t i = 0; i < fElectronBatch.Size(); ++i) {
+    if (!fElectronBatch.IsAccepted(i)) continue;
+    double weight = 1.;
+    if (limited && fEventAvalancheSize >= fEventSizeLimit) {
+      fEventTruncated = true;
+      if (nSkipped++ % fSampleStride != 0) continue;
+      weight = fSampleStride;
+    }
+    TransportElectron(fElectronBatch.X(i), fElectronBatch.Y(i), fElectronBatch.Z(i), fElectronBatch.T(i),
+                      weight);
+  }
 
-  unsigned int ne = 0, ni = 0;
-  drift.GetAvalancheSize(ne, ni);
-  fAvalancheSize = ne;
   fGain = (nsum > 0) ? (static_cast<double>(fAvalancheSize) / nsum) : 0.0;
 
-  // --- CORREÇÃO: Assinatura da função GetElectronEndpoint corrigida ---
-  const unsigned int nEndpoints = drift.GetNumberOfElectronEndpoints();
+  GapResult& result = fGapResults[gap];
+  result.energy += fEnergyDeposit;
+  result.avalancheSize += fAvalancheSize;
+  result.electrons += nsum;
+
+  RPC_LOG_TRACE("[LOG] GarfieldPhysics::DoIt -> Ionization electrons created (nsum): " << nsum << G4endl
+                << "[LOG] GarfieldPhysics::DoIt -> Track avalanche size: " << fAvalancheSize << G4endl
+                << "[LOG] GarfieldPhysics::DoIt -> Calculated Gain: " << fGain);
+}
+
+// Elétrons de condução de um cluster do Heed em fElectronBatch; retorna
+// quantos. Com os secundários ligados o Heed não transporta os delta-elétrons
+// nem reabsorve os fótons: os que passam dos limiares vão para
+// fSecondaryParticles (e fSecondaryEnergy), os outros são transportados aqui.
+std::size_t GarfieldPhysics::AddClusterElectrons(const Garfield::TrackHeed::Cluster& cluster) {
+  if (!createSecondariesInGeant4) {
+    for (const auto& electron : cluster.electrons) {
+      fElectronBatch.Add(electron.x, electron.y, electron.z, electron.t);
+    }
+    return cluster.electrons.size();
+  }
+
+  std::size_t nElectrons = 0;
+  for (const auto& delta : cluster.electrons) {
+    if (delta.e >= fSecondaryElectronThreshold) {
+      fSecondaryParticles.emplace_back("e-", delta.e, delta.t, delta.x, delta.y, delta.z,
+                                       delta.dx, delta.dy, delta.dz);
+      fSecondaryEnergy += delta.e;
+      continue;
+    }
+    int ne = 0;
+    {
+      AllocationCounter::External external;
+      fTrackHeed->TransportDeltaElectron(delta.x, delta.y, delta.z, delta.t, delta.e,
+                                         delta.dx, delta.dy, delta.dz, ne);
+    }
+    for (int k = 0; k < ne; ++k) {
+      double x, y, z, t, e, dx, dy, dz;
+      fTrackHeed->GetElectron(k, x, y, z, t, e, dx, dy, dz);
+      fElectronBatch.Add(x, y, z, t);
+    }
+    nElectrons += ne;
+  }
+
+  for (const auto& photon : cluster.photons) {
+    if (photon.e >= fSecondaryPhotonThreshold) {
+      fSecondaryParticles.emplace_back("gamma", photon.e, photon.t, photon.x, photon.y, photon.z,
+                                       photon.dx, photon.dy, photon.dz);
+      fSecondaryEnergy += photon.e;
+      continue;
+    }
+    Garfield::TrackHeed::Cluster absorbed;
+    {
+      AllocationCounter::External external;
+      absorbed = fTrackHeed->TransportPhoton(photon.x, photon.y, photon.z, photon.t, photon.e,
+                                             photon.dx, photon.dy, photon.dz);
+    }
+    nElectrons += AddClusterElectrons(absorbed);
+  }
+  return nElectrons;
+}
+
+void GarfieldPhysics::TransportElectron(double x, double y, double z, double t, double weight) {
+  if (fAvalancheMode == AvalancheMode::Parameterized && fAvalancheTable) {
+    AvalancheTable::Result r;
+    {
+      Profiler::Scope driftScope(Profiler::kDrift);
+      r = fAvalancheTable->Sample(x, y, z, t);
+    }
+    Profiler::Count(Profiler::kDriftLines);
+    const double size = AddAvalancheSize(x, y, z, t, r.size, weight);
+    AddEndpoint(x, y, z, t, r.x, r.y, r.z, r.t, size);
+    return;
+  }
+
+  // O AvalancheMC zera a avalanche a cada chamada: acumulamos por elétron.
+  {
+    AllocationCounter::External external;
+    Profiler::Scope driftScope(Profiler::kDrift);
+    fAvalancheMC->AvalancheElectron(x, y, z, t);
+  }
+  unsigned int ne = 0, ni = 0;
+  fAvalancheMC->GetAvalancheSize(ne, ni);
+  const double size = AddAvalancheSize(x, y, z, t, ne, weight);
+  // Cada ponto final conta com o peso da amostragem e a fração que sobra
+  // depois da saturação
+  const double segmentWeight = ne > 0 ? size / ne : weight;
+
+  const unsigned int nEndpoints = fAvalancheMC->GetNumberOfElectronEndpoints();
+  Profiler::Count(Profiler::kDriftLines, nEndpoints);
+  const bool profiling = Profiler::IsEnabled();
   for (unsigned int i = 0; i < nEndpoints; ++i) {
       double x1, y1, z1, t1; // Ponto inicial
       double x2, y2, z2, t2; // Ponto final
       int status;
-      // Chamada correta com 10 argumentos
-      drift.GetElectronEndpoint(i, x1, y1, z1, t1, x2, y2, z2, t2, status);
-
-      G4ThreeVector start(x1 * CLHEP::cm, y1 * CLHEP::cm, z1 * CLHEP::cm);
-      G4ThreeVector end(x2 * CLHEP::cm, y2 * CLHEP::cm, z2 * CLHEP::cm);
-      fDriftLines.push_back(std::make_pair(start, end));
+      fAvalancheMC->GetElectronEndpoint(i, x1, y1, z1, t1, x2, y2, z2, t2, status);
+      AddEndpoint(x1, y1, z1, t1, x2, y2, z2, t2, segmentWeight);
+      // O AvalancheMC não expõe os pontos de cada linha: passos estimados
+      // pela distância entre as pontas e o passo fixo do drift.
+      if (profiling) {
+        const double length = std::sqrt((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1) + (z2 - z1) * (z2 - z1));
+        Profiler::Count(Profiler::kDriftSteps, static_cast<std::uint64_t>(std::ceil(length / fDriftStep)));
+      }
   }
-  // ------------------------------------------------------------------
+}
 
-  G4cout << "[LOG] GarfieldPhysics::DoIt -> Ionization electrons created (nsum): " << nsum << G4endl;
-  G4cout << "[LOG] GarfieldPhysics::DoIt -> Total avalanche size: " << fAvalancheSize << G4endl;
-  G4cout << "[LOG] GarfieldPhysics::DoIt -> Calculated Gain: " << fGain << G4endl;
-}
\ No newline at end of file
+// Soma uma avalanche de ne elétrons (já com limite/saturação e peso) ao
+// evento e retorna o tamanho efetivo.
+double GarfieldPhysics::AddAvalancheSize(double x, double y, double z, double t, double ne, double weight) {
+  const double size = weight * SaturatedSize(ne);
+  fAvalancheSize += size;
+  fEventAvalancheSize += size;
+  Profiler::Count(Profiler::kAvalancheSize, static_cast<std::uint64_t>(ne));
+  if (fEventOutput) fEventOutput->AddAvalanche(fGap, x, y, z, t, size);
+  return size;
+}
+
+void GarfieldPhysics::AddEndpoint(double x1, double y1, double z1, double t1,
+                                  double x2, double y2, double z2, double t2, double weight) {
+  if (PadReadout::IsEnabled()) {
+    Profiler::Scope inductionScope(Profiler::kInduction);
+    fPadReadout.AddSegment(x1, y1, z1, t1, x2, y2, z2, t2, weight);
+  }
+  if (fEventOutput) fEventOutput->AddEndpoint(x2, y2, z2, t2);
+  if (!fCollectDriftLines) return;
+  // No mundo, para a visualização: o gap só é deslocado em y
+  const double y0 = fGapCenter.y();
+  fDriftLines.Add(x1 * CLHEP::cm, y1 * CLHEP::cm + y0, z1 * CLHEP::cm,
+                  x2 * CLHEP::cm, y2 * CLHEP::cm + y0, z2 * CLHEP::cm);
+}
@@ -4,9 +4,12 @@
 #include "G4RadioactiveDecayPhysics.hh"
 #include "G4HadronElasticPhysicsHP.hh"
 #include "G4HadronPhysicsQGSP_BERT_HP.hh"
+#include "G4HadronElasticPhysics.hh"
+#include "G4HadronPhysicsQGSP_BERT.hh"
 #include "G4IonPhysics.hh"
 #include "G4NeutronTrackingCut.hh"
-#include "G4EmStandardPhysics_option4.hh" 
+#include "G4EmStandardPhysics_option4.hh"
+#include "G4EmStandardPhysics.hh"
 #include "Physics.hh"
 #include "G4FastSimulationManagerProcess.hh"
 #include "G4EmConfigurator.hh"
@@ -16,38 +19,39 @@
 #include "G4RegionStore.hh"
 #include "G4ProductionCuts.hh"
 #include "G4EmParameters.hh"
+#include "Log.hh"
+#include "PhysicsListMessenger.hh"
 
 
-class CustomEMPhysics : public G4EmStandardPhysics_option4 {
-public:
-    CustomEMPhysics(G4int ver = 1) : G4EmStandardPhysics_option4(ver) {}
-    ~CustomEMPhysics() override = default;
+namespace {
+    // Processo de fast simulation do Garfield e modelo PAIPhot na RegionGarfield,
+    // sobre a EM escolhida
+    void AddGarfieldParameterisation(G4ParticleTable::G4PTblDicIterator* theParticleIterator) {
+        RPC_LOG_INFO("[LOG] PhysicsList::ConstructProcess -> Adicionando a parameterização do Garfield...");
+        GarfieldPhysics::FreezeParticleTables();
+        const ApplicabilityTable& garfieldTable = GarfieldPhysics::GetGarfieldTable();
+        const ApplicabilityTable& geant4Table = GarfieldPhysics::GetGeant4Table();
 
-    void ConstructProcess() override {
-        G4EmStandardPhysics_option4::ConstructProcess();
-
-        G4cout << "[LOG] CustomEMPhysics::ConstructProcess -> Adicionando a parameterização do Garfield..." << G4endl;
-        GarfieldPhysics* garfieldPhysics = GarfieldPhysics::GetInstance();
-
-        auto theParticleIterator = GetParticleIterator();
         theParticleIterator->reset();
         while ((*theParticleIterator)()) {
             G4ParticleDefinition* particle = theParticleIterator->value();
             G4ProcessManager* pmanager = particle->GetProcessManager();
             auto particleName = particle->GetParticleName();
 
-            if (garfieldPhysics->FindParticleName(particleName, "garfield")) {
+            const int index = GarfieldPhysics::GetParticleIndex(particle);
+
+            if (garfieldTable.IsApplicable(index)) {
                 auto fastSimProcess_garfield = new G4FastSimulationManagerProcess("G4FSMP_garfield");
-                G4cout << "[LOG] PhysicsList -> Anexando o processo Garfield FastSim a: " << particleName << G4endl;
+                RPC_LOG_INFO("[LOG] PhysicsList -> Anexando o processo Garfield FastSim a: " << particleName);
                 pmanager->AddDiscreteProcess(fastSimProcess_garfield);
             }
 
-            if (garfieldPhysics->FindParticleName(particleName, "geant4")) {
+            if (geant4Table.IsApplicable(index)) {
                  if (particleName == "gamma") continue;
 
                 G4EmConfigurator* config = G4LossTableManager::Instance()->EmConfigurator();
                 G4PAIPhotModel* paiPhot = new G4PAIPhotModel(particle, "G4PAIModel");
-                 G4cout << "[LOG] PhysicsList -> Anexando o modelo PAIPhot a: " << particleName << G4endl;
+                 RPC_LOG_INFO("[LOG] PhysicsList -> Anexando o modelo PAIPhot a: " << particleName);
 
                 if (particleName == "e-" || particleName == "e+") {
                     config->SetExtraEmModel(particleName, "eIoni", paiPhot, "RegionGarfield", 0, 1e8*MeV, paiPhot);
@@ -61,41 +65,175 @@ public:
             }
         }
     }
-};
+
+    template <class EmPhysics>
+    class CustomEMPhysics : public EmPhysics {
+    public:
+        CustomEMPhysics(G4int ver = 1) : EmPhysics(ver) {}
+        ~CustomEMPhysics() override = default;
+
+        void ConstructProcess() override {
+            EmPhysics::ConstructProcess();
+            AddGarfieldParameterisation(this->GetParticleIterator());
+        }
+    };
+}
 
 PhysicsList::PhysicsList() : G4VModularPhysicsList() {
     SetVerboseLevel(0);
     defaultCutValue = 1 * CLHEP::mm;
 
-    G4EmParameters::Instance()->SetIntegral(false);
+    fHadronElastic = new G4HadronElasticPhysicsHP();
+    fHadronInelastic = new G4HadronPhysicsQGSP_BERT_HP();
+    fRadioactiveDecay = new G4RadioactiveDecayPhysics();
 
     RegisterPhysics(new G4DecayPhysics());
-    RegisterPhysics(new G4RadioactiveDecayPhysics());
-    RegisterPhysics(new G4HadronElasticPhysicsHP());
-    RegisterPhysics(new G4HadronPhysicsQGSP_BERT_HP());
+    RegisterPhysics(fRadioactiveDecay);
+    RegisterPhysics(fHadronElastic);
+    RegisterPhysics(fHadronInelastic);
     RegisterPhysics(new G4IonPhysics());
     RegisterPhysics(new G4NeutronTrackingCut());
-    RegisterPhysics(new CustomEMPhysics());
+    RegisterPhysics(new CustomEMPhysics<G4EmStandardPhysics_option4>());
+    ApplyEmParameters();
+
+    // O vidro e o grafite começam com o corte padrão; o gás com 1 um
+    fRegionCuts["RegionGarfield"] = 1 * um;
+    fRegionCuts["RegionGlass"] = defaultCutValue;
+    fRegionCuts["RegionGraphite"] = defaultCutValue;
 
     GarfieldPhysics* garfieldPhysics = GarfieldPhysics::GetInstance();
     garfieldPhysics->SetIonizationModel("Heed");
+
+    fMessenger = new PhysicsListMessenger(this);
+}
+
+PhysicsList::~PhysicsList() {
+    delete fMessenger;
+}
+
+// Os construtores de EM resetam o G4EmParameters, então isto é refeito a cada troca
+void PhysicsList::ApplyEmParameters() {
+    G4EmParameters* parameters = G4EmParameters::Instance();
+    parameters->SetIntegral(false);
+    if (fEmOption != "opt4") {
+        parameters->AddPhysics("RegionGarfield", "G4EmStandard_opt4");
+    }
+}
+
+void PhysicsList::SetPreset(const G4String& preset) {
+    if (preset == "full") {
+        SetEmOption("opt4");
+        SetHadronic("hp");
+        SetRadioactiveDecay(true);
+    } else if (preset == "fast") {
+        SetEmOption("opt0");
+        SetHadronic("bert");
+        SetRadioactiveDecay(false);
+    } else {
+        RPC_LOG_ERROR("[LOG] PhysicsList::SetPreset -> Preset desconhecido: " << preset);
+        return;
+    }
+    RPC_LOG_INFO("[LOG] PhysicsList::SetPreset -> Preset " << preset << ": EM " << fEmOption
+                 << ", hadrônica " << fHadronic << ", decaimento radioativo "
+                 << (GetRadioactiveDecay() ? "ligado" : "desligado"));
 }
 
-PhysicsList::~PhysicsList() {}
+void PhysicsList::SetEmOption(const G4String& option) {
+    if (option == fEmOption) return;
+    if (option == "opt4") {
+        ReplacePhysics(new CustomEMPhysics<G4EmStandardPhysics_option4>());
+    } else if (option == "opt0") {
+        ReplacePhysics(new CustomEMPhysics<G4EmStandardPhysics>());
+    } else {
+        RPC_LOG_ERROR("[LOG] PhysicsList::SetEmOption -> Opção EM desconhecida: " << option);
+        return;
+    }
+    fEmOption = option;
+    ApplyEmParameters();
+}
+
+void PhysicsList::SetHadronic(const G4String& model) {
+    if (model == fHadronic) return;
+    if (model != "hp" && model != "bert" && model != "none") {
+        RPC_LOG_ERROR("[LOG] PhysicsList::SetHadronic -> Modelo hadrônico desconhecido: " << model);
+        return;
+    }
+
+    // RemovePhysics só tira o construtor da lista
+    if (fHadronElastic) {
+        RemovePhysics(fHadronElastic);
+        RemovePhysics(fHadronInelastic);
+        delete fHadronElastic;
+        delete fHadronInelastic;
+        fHadronElastic = nullptr;
+        fHadronInelastic = nullptr;
+    }
+
+    if (model == "hp") {
+        fHadronElastic = new G4HadronElasticPhysicsHP();
+        fHadronInelastic = new G4HadronPhysicsQGSP_BERT_HP();
+    } else if (model == "bert") {
+        fHadronElastic = new G4HadronElasticPhysics();
+        fHadronInelastic = new G4HadronPhysicsQGSP_BERT();
+    }
+    if (fHadronElastic) {
+        RegisterPhysics(fHadronElastic);
+        RegisterPhysics(fHadronInelastic);
+    }
+    fHadronic = model;
+}
+
+void PhysicsList::SetRadioactiveDecay(G4bool flag) {
+    if (flag == GetRadioactiveDecay()) return;
+    if (flag) {
+        fRadioactiveDecay = new G4RadioactiveDecayPhysics();
+        RegisterPhysics(fRadioactiveDecay);
+    } else {
+        RemovePhysics(fRadioactiveDecay);
+        delete fRadioactiveDecay;
+        fRadioactiveDecay = nullptr;
+    }
+}
+
+void PhysicsList::SetRegionCut(const G4String& region, G4double cut) {
+    fRegionCuts[region] = cut;
+    // Antes do /run/initialize as regiões ainda não existem e o SetCuts aplica
+    if (G4RegionStore::GetInstance()->GetRegion(region, false)) {
+        ApplyRegionCut(region, cut);
+    }
+}
+
+G4double PhysicsList::GetRegionCut(const G4String& region) const {
+    auto it = fRegionCuts.find(region);
+    return it != fRegionCuts.end() ? it->second : defaultCutValue;
+}
+
+void PhysicsList::ApplyRegionCut(const G4String& name, G4double cut) const {
+    G4RegionStore* store = G4RegionStore::GetInstance();
+    G4Region* region = store->GetRegion(name, false);
+    if (!region) {
+        RPC_LOG_ERROR("[LOG] PhysicsList::SetCuts -> ERRO: " << name << " não encontrada!");
+        return;
+    }
+
+    // Os cortes da região do mundo são compartilhados; nunca mexer neles
+    G4Region* world = store->GetRegion("DefaultRegionForTheWorld", false);
+    G4ProductionCuts* cuts = region->GetProductionCuts();
+    if (!cuts || (world && cuts == world->GetProductionCuts())) {
+        cuts = new G4ProductionCuts();
+        region->SetProductionCuts(cuts);
+    }
+    cuts->SetProductionCut(cut, G4ProductionCuts::GetIndex("gamma"));
+    cuts->SetProductionCut(cut, G4ProductionCuts::GetIndex("e-"));
+    cuts->SetProductionCut(cut, G4ProductionCuts::GetIndex("e+"));
+    RPC_LOG_INFO("[LOG] PhysicsList::SetCuts -> Cortes de produção da " << name << ": " << cut / um << " um");
+}
 
 void PhysicsList::SetCuts() {
     G4ProductionCutsTable::GetProductionCutsTable()->SetEnergyRange(100. * eV, 100. * TeV);
     SetCutsWithDefault();
-    G4Region* region = G4RegionStore::GetInstance()->GetRegion("RegionGarfield");
-    G4ProductionCuts* cuts = new G4ProductionCuts();
-    cuts->SetProductionCut(1 * um, G4ProductionCuts::GetIndex("gamma"));
-    cuts->SetProductionCut(1 * um, G4ProductionCuts::GetIndex("e-"));
-    cuts->SetProductionCut(1 * um, G4ProductionCuts::GetIndex("e+"));
-    if (region) {
-        G4cout << "[LOG] PhysicsList::SetCuts -> Aplicando cortes de produção especiais à RegionGarfield." << G4endl;
-        region->SetProductionCuts(cuts);
-    } else {
-        G4cout << "[LOG] PhysicsList::SetCuts -> ERRO: RegionGarfield não encontrada!" << G4endl;
+    for (const auto& entry : fRegionCuts) {
+        ApplyRegionCut(entry.first, entry.second);
     }
     DumpCutValuesTable();
 }
@@ -107,5 +245,7 @@ void PhysicsList::ConstructParticle()
 
 void PhysicsList::ConstructProcess()
 {
+    RPC_LOG_INFO("[LOG] PhysicsList::ConstructProcess -> EM " << fEmOption << ", hadrônica " << fHadronic
+                 << ", decaimento radioativo " << (GetRadioactiveDecay() ? "ligado" : "desligado"));
     G4VModularPhysicsList::ConstructProcess();
-}
\ No newline at end of file
+}
@@ -0,0 +1,106 @@
+#include "PhysicsListMessenger.hh"
+#include "PhysicsList.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+// A PhysicsList existe só no master (os workers usam os mesmos construtores),
+// então os comandos não são repassados às threads.
+PhysicsListMessenger::PhysicsListMessenger(PhysicsList* physicsList)
+: fPhysicsList(physicsList) {
+  fPhysicsDir = new G4UIdirectory("/rpc/physics/");
+  fPhysicsDir->SetGuidance("Construtores de física e cortes de produção por região.");
+
+  fPresetCmd = MakeChoiceCommand("/rpc/physics/preset",
+                                 "full: EM option4, QGSP_BERT_HP e decaimento radioativo (padrão).", "full fast");
+  fPresetCmd->SetGuidance("fast: EM option0 fora do gás, QGSP_BERT sem HP e sem decaimento radioativo.");
+  fEmCmd = MakeChoiceCommand("/rpc/physics/em",
+                             "EM fora do gás; com opt0 a RegionGarfield continua com a option4.", "opt4 opt0");
+  fHadronicCmd = MakeChoiceCommand("/rpc/physics/hadronic",
+                                   "Física hadrônica: QGSP_BERT_HP, QGSP_BERT ou nenhuma.", "hp bert none");
+
+  fRadioactiveDecayCmd = new G4UIcmdWithABool("/rpc/physics/radioactiveDecay", this);
+  fRadioactiveDecayCmd->SetGuidance("Registra o G4RadioactiveDecayPhysics.");
+  fRadioactiveDecayCmd->SetGuidance("Só antes do /run/initialize.");
+  fRadioactiveDecayCmd->SetParameterName("flag", true);
+  fRadioactiveDecayCmd->SetDefaultValue(true);
+  fRadioactiveDecayCmd->AvailableForStates(G4State_PreInit);
+  fRadioactiveDecayCmd->SetToBeBroadcasted(false);
+
+  fGasCutCmd = MakeCutCommand("/rpc/physics/gasCut", "Corte de produção de gamma, e- e e+ na RegionGarfield (gás).");
+  fGlassCutCmd = MakeCutCommand("/rpc/physics/glassCut", "Corte de produção de gamma, e- e e+ na RegionGlass (eletrodos de vidro).");
+  fGraphiteCutCmd = MakeCutCommand("/rpc/physics/graphiteCut", "Corte de produção de gamma, e- e e+ na RegionGraphite.");
+}
+
+PhysicsListMessenger::~PhysicsListMessenger() {
+  delete fGraphiteCutCmd;
+  delete fGlassCutCmd;
+  delete fGasCutCmd;
+  delete fRadioactiveDecayCmd;
+  delete fHadronicCmd;
+  delete fEmCmd;
+  delete fPresetCmd;
+  delete fPhysicsDir;
+}
+
+G4UIcmdWithAString* PhysicsListMessenger::MakeChoiceCommand(const char* path, const char* guidance,
+                                                           const char* candidates) {
+  auto* cmd = new G4UIcmdWithAString(path, this);
+  cmd->SetGuidance(guidance);
+  cmd->SetGuidance("Só antes do /run/initialize.");
+  cmd->SetParameterName("choice", false);
+  cmd->SetCandidates(candidates);
+  cmd->AvailableForStates(G4State_PreInit);
+  cmd->SetToBeBroadcasted(false);
+  return cmd;
+}
+
+G4UIcmdWithADoubleAndUnit* PhysicsListMessenger::MakeCutCommand(const char* path, const char* guidance) {
+  auto* cmd = new G4UIcmdWithADoubleAndUnit(path, this);
+  cmd->SetGuidance(guidance);
+  cmd->SetGuidance("Entre runs, vale a partir do próximo /run/beamOn.");
+  cmd->SetParameterName("cut", false);
+  cmd->SetRange("cut > 0.");
+  cmd->SetUnitCategory("Length");
+  cmd->SetDefaultUnit("mm");
+  cmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  cmd->SetToBeBroadcasted(false);
+  return cmd;
+}
+
+void PhysicsListMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+  if (command == fPresetCmd) {
+    fPhysicsList->SetPreset(newValue);
+  } else if (command == fEmCmd) {
+    fPhysicsList->SetEmOption(newValue);
+  } else if (command == fHadronicCmd) {
+    fPhysicsList->SetHadronic(newValue);
+  } else if (command == fRadioactiveDecayCmd) {
+    fPhysicsList->SetRadioactiveDecay(fRadioactiveDecayCmd->GetNewBoolValue(newValue));
+  } else if (command == fGasCutCmd) {
+    fPhysicsList->SetRegionCut("RegionGarfield", fGasCutCmd->GetNewDoubleValue(newValue));
+  } else if (command == fGlassCutCmd) {
+    fPhysicsList->SetRegionCut("RegionGlass", fGlassCutCmd->GetNewDoubleValue(newValue));
+  } else if (command == fGraphiteCutCmd) {
+    fPhysicsList->SetRegionCut("RegionGraphite", fGraphiteCutCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+G4String PhysicsListMessenger::GetCurrentValue(G4UIcommand* command) {
+  if (command == fEmCmd) return fPhysicsList->GetEmOption();
+  if (command == fHadronicCmd) return fPhysicsList->GetHadronic();
+  if (command == fRadioactiveDecayCmd) {
+    return fRadioactiveDecayCmd->ConvertToString(fPhysicsList->GetRadioactiveDecay());
+  }
+  if (command == fGasCutCmd) {
+    return fGasCutCmd->ConvertToString(fPhysicsList->GetRegionCut("RegionGarfield"), "mm");
+  }
+  if (command == fGlassCutCmd) {
+    return fGlassCutCmd->ConvertToString(fPhysicsList->GetRegionCut("RegionGlass"), "mm");
+  }
+  if (command == fGraphiteCutCmd) {
+    return fGraphiteCutCmd->ConvertToString(fPhysicsList->GetRegionCut("RegionGraphite"), "mm");
+  }
+  return "";
+}
@@ -3,14 +3,36 @@
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
+#include "G4MuonMinus.hh"
+#include "G4MuonPlus.hh"
 #include "G4SystemOfUnits.hh"
 #include "Randomize.hh"
+#include "DetectorParameters.hh"
+#include "EventSeeds.hh"
+#include "Log.hh"
+
+PrimaryGeneratorAction::Mode PrimaryGeneratorAction::fMode = PrimaryGeneratorAction::kHemisphere;
+G4String PrimaryGeneratorAction::fParticleName = "mu-";
+G4int PrimaryGeneratorAction::fParticleVersion = 0;
+G4double PrimaryGeneratorAction::fEnergy = 5. * GeV;
+G4double PrimaryGeneratorAction::fMaxZenith = 75. * deg;
+G4double PrimaryGeneratorAction::fMinMomentum = 1. * GeV;
+G4double PrimaryGeneratorAction::fMaxMomentum = 1. * TeV;
+G4double PrimaryGeneratorAction::fChargeRatio = 1.27;
+G4int PrimaryGeneratorAction::fSpectrumVersion = 0;
+
+namespace {
+    // Folga entre o topo da pilha e o plano dos vértices do modo cósmico
+    constexpr G4double kSourceMargin = 1. * mm;
+}
 
 PrimaryGeneratorAction::PrimaryGeneratorAction()
     : G4VUserPrimaryGeneratorAction(), fParticleGun(0) 
 {
     G4int nofParticles = 1;
     fParticleGun = new G4ParticleGun(nofParticles);
+    fMuonMinus = G4MuonMinus::Definition();
+    fMuonPlus = G4MuonPlus::Definition();
 }
 
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
@@ -18,14 +40,64 @@ PrimaryGeneratorAction::~PrimaryGeneratorAction()
     delete fParticleGun;
 }
 
+void PrimaryGeneratorAction::SetParticleName(const G4String& name)
+{
+    fParticleName = name;
+    ++fParticleVersion;
+}
+
+void PrimaryGeneratorAction::SetMomentumRange(G4double pMin, G4double pMax)
+{
+    fMinMomentum = pMin;
+    fMaxMomentum = pMax;
+    ++fSpectrumVersion;
+}
+
+G4double PrimaryGeneratorAction::GetLiveTimePerEvent()
+{
+    CosmicMuonSpectrum spectrum;
+    spectrum.Build(fMinMomentum, fMaxMomentum);
+    const DetectorParameters* detector = DetectorParameters::Instance();
+    // Fluxo por um plano horizontal: int I0 cos^2 cos dOmega = pi I0 (1 - cos^4) / 2
+    const G4double c = std::cos(fMaxZenith);
+    const G4double flux = 0.5 * CLHEP::pi * (1. - c * c * c * c) * spectrum.GetIntegratedVerticalIntensity();
+    const G4double rate = flux * sr * detector->GetSizeX() * detector->GetSizeZ();
+    return rate > 0. ? 1. / rate : 0.;
+}
 
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event *anEvent)
 {
-    G4ParticleDefinition* particle = G4ParticleTable::GetParticleTable()->FindParticle("mu-");
-    fParticleGun->SetParticleDefinition(particle);
-    fParticleGun->SetParticleEnergy(5. * GeV);
+    // Primeiro passo do evento na thread: daqui em diante os geradores do
+    // Geant4 e do Garfield++ só dependem de (run, índice do evento)
+    EventSeeds::SeedEvent(EventSeeds::GetEventIndex(anEvent->GetEventID()));
+
+    if (fMode == kCosmic) {
+        GenerateCosmic();
+    } else {
+        GenerateHemisphere();
+    }
+    fParticleGun->GeneratePrimaryVertex(anEvent);
+}
+
+void PrimaryGeneratorAction::GenerateHemisphere()
+{
+    // A definição só é procurada quando o nome muda
+    if (fResolvedParticleVersion != fParticleVersion) {
+        fParticle = G4ParticleTable::GetParticleTable()->FindParticle(fParticleName);
+        if (!fParticle) {
+            RPC_LOG_ERROR("[LOG] PrimaryGeneratorAction -> Partícula desconhecida: " << fParticleName << "; usando mu-");
+            fParticle = fMuonMinus;
+        }
+        fResolvedParticleVersion = fParticleVersion;
+    }
+    fParticleGun->SetParticleDefinition(fParticle);
+    fParticleGun->SetParticleEnergy(fEnergy);
 
-    G4double rWorld = 1.5 * m;
+    // Ponto na semiesfera de raio rWorld em torno do centro do gap, apontando
+    // para ele; o mundo tem o mesmo raio, centrado na origem.
+    const DetectorParameters* detector = DetectorParameters::Instance();
+    G4double rWorld = detector->GetWorldRadius() - 0.5 * detector->GetTotalThickness();
+    G4ThreeVector target = detector->GetGasCenter();
 
     G4double theta_pos = G4RandFlat::shoot(0., 0.5 * CLHEP::pi);
     G4double phi_pos = G4RandFlat::shoot(0., 2. * CLHEP::pi);
@@ -35,10 +107,41 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event *anEvent)
     G4double z_pos = rWorld * std::cos(theta_pos);
     
     G4ThreeVector pos(x_pos, y_pos, z_pos);
-    fParticleGun->SetParticlePosition(pos);
+    fParticleGun->SetParticlePosition(target + pos);
 
     G4ThreeVector mom_direction = -pos;
     fParticleGun->SetParticleMomentumDirection(mom_direction.unit());
-    
-    fParticleGun->GeneratePrimaryVertex(anEvent);
-}
\ No newline at end of file
+}
+
+void PrimaryGeneratorAction::GenerateCosmic()
+{
+    if (fBuiltSpectrumVersion != fSpectrumVersion || !fSpectrum.IsBuilt()) {
+        fSpectrum.Build(fMinMomentum, fMaxMomentum);
+        fBuiltSpectrumVersion = fSpectrumVersion;
+    }
+
+    const G4double ratio = fChargeRatio;
+    fParticleGun->SetParticleDefinition(G4UniformRand() < ratio / (1. + ratio) ? fMuonPlus : fMuonMinus);
+
+    // Fluxo pelo plano horizontal ~ cos^2(theta) * cos(theta) dcos(theta):
+    // cos(theta) = (c0^4 + u (1 - c0^4))^(1/4). O eixo vertical é y.
+    const G4double c0 = std::cos(fMaxZenith);
+    const G4double c0_4 = c0 * c0 * c0 * c0;
+    const G4double cosTheta = std::pow(c0_4 + G4UniformRand() * (1. - c0_4), 0.25);
+    const G4double sinTheta = std::sqrt(std::max(0., 1. - cosTheta * cosTheta));
+    const G4double phi = 2. * CLHEP::pi * G4UniformRand();
+    const G4ThreeVector direction(sinTheta * std::cos(phi), -cosTheta, sinTheta * std::sin(phi));
+
+    fParticleGun->SetParticleMomentum(fSpectrum.SampleVerticalMomentum(G4UniformRand()) / cosTheta);
+    fParticleGun->SetParticleMomentumDirection(direction);
+
+    // Ponto no plano médio do gás, uniforme na área da câmara, recuado ao
+    // longo da direção até logo acima do alumínio de cima.
+    const DetectorParameters* detector = DetectorParameters::Instance();
+    const G4ThreeVector center = detector->GetGasCenter();
+    const G4ThreeVector crossing(center.x() + (G4UniformRand() - 0.5) * detector->GetSizeX(),
+                                 center.y(),
+                                 center.z() + (G4UniformRand() - 0.5) * detector->GetSizeZ());
+    const G4double height = 0.5 * detector->GetTotalThickness() + kSourceMargin - center.y();
+    fParticleGun->SetParticlePosition(crossing - direction * (height / cosTheta));
+}
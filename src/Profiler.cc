@@ -0,0 +1,237 @@
+#include "Profiler.hh"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <sstream>
+#include <vector>
+#include "Log.hh"
+
+std::atomic<bool> Profiler::fEnabled{false};
+
+namespace {
+  const char* const kPhaseNames[Profiler::kNumberOfPhases] = {
+      "event", "heed", "drift", "induction", "analysis"};
+  const char* const kCounterNames[Profiler::kNumberOfCounters] = {
+      "steps", "clusters", "electrons", "avalancheSize", "driftLines", "driftSteps"};
+
+  // Uma amostra por evento. Tempos em ms; float basta para percentis e
+  // mantém ~60 B por evento.
+  struct EventSample {
+    std::array<float, Profiler::kNumberOfPhases> ms;
+    std::array<float, Profiler::kNumberOfCounters> counts;
+    long event;
+  };
+
+  // Eventos mais lentos listados no relatório
+  constexpr std::size_t kSlowestEvents = 5;
+
+  struct ThreadData {
+    std::chrono::steady_clock::time_point eventStart;
+    bool inEvent = false;
+    std::array<std::chrono::steady_clock::duration, Profiler::kNumberOfPhases> time{};
+    std::array<std::uint64_t, Profiler::kNumberOfCounters> counts{};
+    std::vector<EventSample> samples;
+  };
+
+  thread_local ThreadData tData;
+
+  std::mutex gMutex;
+  std::string gFileName = "profile.json";
+  std::vector<EventSample> gSamples;
+  int gThreads = 0;
+
+  struct Summary {
+    double total = 0.;
+    double mean = 0.;
+    double p50 = 0.;
+    double p90 = 0.;
+    double p99 = 0.;
+    double max = 0.;
+  };
+
+  // values é reordenado
+  Summary Summarize(std::vector<float>& values) {
+    Summary s;
+    if (values.empty()) return s;
+    for (float v : values) s.total += v;
+    s.mean = s.total / values.size();
+    auto percentile = [&values](double q) {
+      const std::size_t k = std::min(values.size() - 1, static_cast<std::size_t>(q * values.size()));
+      std::nth_element(values.begin(), values.begin() + k, values.end());
+      return static_cast<double>(values[k]);
+    };
+    s.p50 = percentile(0.50);
+    s.p90 = percentile(0.90);
+    s.p99 = percentile(0.99);
+    s.max = *std::max_element(values.begin(), values.end());
+    return s;
+  }
+
+  void WriteSummary(std::ostream& out, const Summary& s, double totalScale, const char* totalKey,
+                    const char* unit) {
+    out << "{\"" << totalKey << "\": " << s.total * totalScale << ", \"mean" << unit << "\": " << s.mean
+        << ", \"p50" << unit << "\": " << s.p50 << ", \"p90" << unit << "\": " << s.p90
+        << ", \"p99" << unit << "\": " << s.p99 << ", \"max" << unit << "\": " << s.max << "}";
+  }
+}
+
+void Profiler::SetFileName(const std::string& fileName) {
+  std::lock_guard<std::mutex> lock(gMutex);
+  gFileName = fileName;
+}
+
+std::string Profiler::GetFileName() {
+  std::lock_guard<std::mutex> lock(gMutex);
+  return gFileName;
+}
+
+void Profiler::AddTime(Phase phase, std::chrono::steady_clock::duration elapsed) {
+  tData.time[phase] += elapsed;
+}
+
+void Profiler::AddCount(Counter counter, std::uint64_t value) {
+  tData.counts[counter] += value;
+}
+
+void Profiler::BeginEvent() {
+  ThreadData& data = tData;
+  data.time.fill(std::chrono::steady_clock::duration::zero());
+  data.counts.fill(0);
+  data.inEvent = IsEnabled();
+  if (data.inEvent) data.eventStart = std::chrono::steady_clock::now();
+}
+
+void Profiler::EndEvent(long eventIndex) {
+  ThreadData& data = tData;
+  if (!data.inEvent) return;
+  data.inEvent = false;
+  data.time[kEvent] = std::chrono::steady_clock::now() - data.eventStart;
+
+  EventSample sample;
+  for (int i = 0; i < kNumberOfPhases; ++i) {
+    sample.ms[i] = std::chrono::duration<float, std::milli>(data.time[i]).count();
+  }
+  for (int i = 0; i < kNumberOfCounters; ++i) sample.counts[i] = static_cast<float>(data.counts[i]);
+  sample.event = eventIndex;
+  data.samples.push_back(sample);
+}
+
+void Profiler::MergeThread() {
+  ThreadData& data = tData;
+  if (data.samples.empty()) return;
+  std::lock_guard<std::mutex> lock(gMutex);
+  gSamples.insert(gSamples.end(), data.samples.begin(), data.samples.end());
+  ++gThreads;
+  data.samples.clear();
+}
+
+void Profiler::Report(int runId) {
+  std::vector<EventSample> samples;
+  int nThreads = 0;
+  std::string fileName;
+  {
+    std::lock_guard<std::mutex> lock(gMutex);
+    samples.swap(gSamples);
+    nThreads = gThreads;
+    gThreads = 0;
+    fileName = gFileName;
+  }
+  if (samples.empty()) return;
+
+  const std::size_t nEvents = samples.size();
+  std::vector<float> values(nEvents);
+
+  // Fases medidas e a do Geant4 (evento menos as demais), por evento
+  std::array<Summary, kNumberOfPhases> phases;
+  for (int p = 0; p < kNumberOfPhases; ++p) {
+    for (std::size_t i = 0; i < nEvents; ++i) values[i] = samples[i].ms[p];
+    phases[p] = Summarize(values);
+  }
+  for (std::size_t i = 0; i < nEvents; ++i) {
+    float rest = samples[i].ms[kEvent];
+    for (int p = kHeed; p < kNumberOfPhases; ++p) rest -= samples[i].ms[p];
+    values[i] = std::max(0.f, rest);
+  }
+  const Summary geant4 = Summarize(values);
+
+  std::array<Summary, kNumberOfCounters> counters;
+  for (int c = 0; c < kNumberOfCounters; ++c) {
+    for (std::size_t i = 0; i < nEvents; ++i) values[i] = samples[i].counts[c];
+    counters[c] = Summarize(values);
+  }
+
+  // Tabela
+  const double eventTotal = phases[kEvent].total;
+  std::ostringstream table;
+  table << std::fixed << std::setprecision(3);
+  table << "[LOG] Profiler::Report -> Run " << runId << ": " << nEvents << " eventos, " << nThreads
+        << " thread(s)\n";
+  table << "    fase          total [s]   fração   média [ms]   p50 [ms]   p90 [ms]   p99 [ms]   max [ms]\n";
+  auto phaseRow = [&table, eventTotal](const char* name, const Summary& s) {
+    table << "    " << std::left << std::setw(12) << name << std::right << std::setw(11) << s.total / 1e3
+          << std::setw(8) << std::setprecision(1) << (eventTotal > 0. ? 100. * s.total / eventTotal : 0.)
+          << "%" << std::setprecision(3) << std::setw(13) << s.mean << std::setw(11) << s.p50
+          << std::setw(11) << s.p90 << std::setw(11) << s.p99 << std::setw(11) << s.max << "\n";
+  };
+  phaseRow("geant4", geant4);
+  for (int p = kHeed; p < kNumberOfPhases; ++p) phaseRow(kPhaseNames[p], phases[p]);
+  phaseRow(kPhaseNames[kEvent], phases[kEvent]);
+  table << "    contador            total        média          p50        p99        max\n";
+  for (int c = 0; c < kNumberOfCounters; ++c) {
+    const Summary& s = counters[c];
+    table << "    " << std::left << std::setw(14) << kCounterNames[c] << std::right << std::setprecision(0)
+          << std::setw(11) << s.total << std::setprecision(1) << std::setw(13) << s.mean
+          << std::setprecision(0) << std::setw(13) << s.p50 << std::setw(11) << s.p99 << std::setw(11)
+          << s.max << (c + 1 < kNumberOfCounters ? "\n" : "");
+  }
+
+  // Cauda: os eventos mais lentos, para refazer com /rpc/replayEvent
+  const std::size_t nSlowest = std::min(kSlowestEvents, nEvents);
+  std::partial_sort(samples.begin(), samples.begin() + nSlowest, samples.end(),
+                    [](const EventSample& a, const EventSample& b) { return a.ms[kEvent] > b.ms[kEvent]; });
+  table << "\n    mais lentos (/rpc/replayEvent " << runId << " <evento>):";
+  for (std::size_t i = 0; i < nSlowest; ++i) {
+    table << " " << samples[i].event << " (" << std::setprecision(1) << samples[i].ms[kEvent] << " ms)";
+  }
+  RPC_LOG_INFO(table.str());
+
+  // Um arquivo por run: profile.json, profile_run1.json, ...
+  if (runId > 0) {
+    const std::size_t dot = fileName.find_last_of('.');
+    const std::size_t slash = fileName.find_last_of('/');
+    const std::string suffix = "_run" + std::to_string(runId);
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) fileName += suffix;
+    else fileName.insert(dot, suffix);
+  }
+
+  // JSON
+  std::ofstream out(fileName);
+  if (!out) {
+    RPC_LOG_ERROR("[LOG] Profiler::Report -> Não foi possível escrever " << fileName);
+    return;
+  }
+  out << std::setprecision(6);
+  out << "{\n  \"run\": " << runId << ",\n  \"events\": " << nEvents << ",\n  \"threads\": " << nThreads
+      << ",\n  \"phases\": {\n    \"geant4\": ";
+  WriteSummary(out, geant4, 1e-3, "total_s", "_ms");
+  for (int p = kHeed; p < kNumberOfPhases; ++p) {
+    out << ",\n    \"" << kPhaseNames[p] << "\": ";
+    WriteSummary(out, phases[p], 1e-3, "total_s", "_ms");
+  }
+  out << ",\n    \"" << kPhaseNames[kEvent] << "\": ";
+  WriteSummary(out, phases[kEvent], 1e-3, "total_s", "_ms");
+  out << "\n  },\n  \"counters\": {";
+  for (int c = 0; c < kNumberOfCounters; ++c) {
+    out << (c ? ",\n    \"" : "\n    \"") << kCounterNames[c] << "\": ";
+    WriteSummary(out, counters[c], 1., "total", "");
+  }
+  out << "\n  },\n  \"slowest\": [";
+  for (std::size_t i = 0; i < nSlowest; ++i) {
+    out << (i ? ", " : "") << "{\"event\": " << samples[i].event << ", \"ms\": " << samples[i].ms[kEvent] << "}";
+  }
+  out << "]\n}\n";
+  RPC_LOG_INFO("[LOG] Profiler::Report -> Perfil gravado em " << fileName);
+}
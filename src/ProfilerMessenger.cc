@@ -0,0 +1,44 @@
+#include "ProfilerMessenger.hh"
+#include "Profiler.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+
+// O estado do Profiler é global ao processo: basta aplicar no master.
+ProfilerMessenger::ProfilerMessenger() {
+  fProfileDir = new G4UIdirectory("/rpc/profile/");
+  fProfileDir->SetGuidance("Tempo por fase e contadores por evento.");
+
+  fEnableCmd = new G4UIcmdWithABool("/rpc/profile/enable", this);
+  fEnableCmd->SetGuidance("Mede as fases (Heed, drift, indução, análise) e escreve o resumo no fim do run.");
+  fEnableCmd->SetParameterName("flag", true);
+  fEnableCmd->SetDefaultValue(true);
+  fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEnableCmd->SetToBeBroadcasted(false);
+
+  fFileCmd = new G4UIcmdWithAString("/rpc/profile/file", this);
+  fFileCmd->SetGuidance("Arquivo JSON do resumo; os runs seguintes ao primeiro ganham o sufixo _run<N>.");
+  fFileCmd->SetParameterName("fileName", false);
+  fFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fFileCmd->SetToBeBroadcasted(false);
+}
+
+ProfilerMessenger::~ProfilerMessenger() {
+  delete fFileCmd;
+  delete fEnableCmd;
+  delete fProfileDir;
+}
+
+void ProfilerMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+  if (command == fEnableCmd) {
+    Profiler::SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+  } else if (command == fFileCmd) {
+    Profiler::SetFileName(newValue);
+  }
+}
+
+G4String ProfilerMessenger::GetCurrentValue(G4UIcommand* command) {
+  if (command == fEnableCmd) return G4UIcommand::ConvertToString(Profiler::IsEnabled());
+  if (command == fFileCmd) return Profiler::GetFileName();
+  return "";
+}
@@ -0,0 +1,85 @@
+#include "RandomMessenger.hh"
+#include "EventSeeds.hh"
+#include "Log.hh"
+#include "G4RunManager.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithAString.hh"
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+// As sementes são estado do processo lido pelas threads no run; o replay é
+// um BeamOn do master. Os comandos só rodam no master.
+RandomMessenger::RandomMessenger() {
+  fRandomDir = new G4UIdirectory("/rpc/random/");
+  fRandomDir->SetGuidance("Sementes por evento do Geant4 e do Garfield++.");
+
+  fSeedCmd = new G4UIcmdWithAString("/rpc/random/seed", this);
+  fSeedCmd->SetGuidance("Semente da campanha (inteiro de 64 bits); a semente de cada run é derivada dela e do número do run.");
+  fSeedCmd->SetGuidance("0 (padrão): a semente do run sai do gerador do master, que segue /random/setSeeds.");
+  fSeedCmd->SetParameterName("seed", false);
+  fSeedCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSeedCmd->SetToBeBroadcasted(false);
+
+  fEventOffsetCmd = new G4UIcmdWithAnInteger("/rpc/random/eventOffset", this);
+  fEventOffsetCmd->SetGuidance("Índice global do primeiro evento do run (coluna Event do ntuple).");
+  fEventOffsetCmd->SetGuidance("Jobs com a mesma semente e faixas de índices disjuntas não repetem eventos.");
+  fEventOffsetCmd->SetParameterName("offset", false);
+  fEventOffsetCmd->SetRange("offset >= 0");
+  fEventOffsetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEventOffsetCmd->SetToBeBroadcasted(false);
+
+  fReplayCmd = new G4UIcommand("/rpc/replayEvent", this);
+  fReplayCmd->SetGuidance("Refaz um único evento, identificado pelas colunas Run e Event do ntuple.");
+  fReplayCmd->SetGuidance("Em outro processo, precisa da mesma /rpc/random/seed, geometria, física e macro.");
+  auto* runParam = new G4UIparameter("run", 'i', false);
+  runParam->SetParameterRange("run >= 0");
+  fReplayCmd->SetParameter(runParam);
+  auto* eventParam = new G4UIparameter("event", 'i', false);
+  eventParam->SetParameterRange("event >= 0");
+  fReplayCmd->SetParameter(eventParam);
+  fReplayCmd->AvailableForStates(G4State_Idle);
+  fReplayCmd->SetToBeBroadcasted(false);
+}
+
+RandomMessenger::~RandomMessenger() {
+  delete fReplayCmd;
+  delete fEventOffsetCmd;
+  delete fSeedCmd;
+  delete fRandomDir;
+}
+
+void RandomMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+  if (command == fSeedCmd) {
+    std::istringstream is(newValue);
+    std::uint64_t seed = 0;
+    if (!(is >> seed)) {
+      RPC_LOG_ERROR("[LOG] RandomMessenger -> Semente inválida: " << newValue);
+      return;
+    }
+    EventSeeds::SetSeed(seed);
+  } else if (command == fEventOffsetCmd) {
+    EventSeeds::SetEventOffset(fEventOffsetCmd->GetNewIntValue(newValue));
+  } else if (command == fReplayCmd) {
+    std::istringstream is(newValue);
+    G4int run = 0;
+    G4int event = 0;
+    is >> run >> event;
+    if (!EventSeeds::SetReplay(run, event)) {
+      RPC_LOG_ERROR("[LOG] RandomMessenger -> A semente do run " << run
+                    << " não é conhecida neste processo; defina /rpc/random/seed.");
+      return;
+    }
+    G4RunManager::GetRunManager()->BeamOn(1);
+    EventSeeds::ClearReplay();
+  }
+}
+
+G4String RandomMessenger::GetCurrentValue(G4UIcommand* command) {
+  if (command == fSeedCmd) return std::to_string(EventSeeds::GetSeed());
+  if (command == fEventOffsetCmd) return fEventOffsetCmd->ConvertToString(static_cast<G4int>(EventSeeds::GetEventOffset()));
+  return "";
+}
@@ -0,0 +1,80 @@
+#include "ReadoutMessenger.hh"
+#include "PadReadout.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+
+// A configuração da leitura é compartilhada e lida pelas threads no início
+// de cada run, então os comandos só precisam rodar no master.
+ReadoutMessenger::ReadoutMessenger() {
+  fReadoutDir = new G4UIdirectory("/rpc/readout/");
+  fReadoutDir->SetGuidance("Leitura dos pads por sinal induzido.");
+
+  fEnableCmd = new G4UIcmdWithABool("/rpc/readout/enable", this);
+  fEnableCmd->SetGuidance("Calcula a carga e o sinal induzidos em cada pad.");
+  fEnableCmd->SetParameterName("flag", true);
+  fEnableCmd->SetDefaultValue(true);
+  fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEnableCmd->SetToBeBroadcasted(false);
+
+  fThresholdCmd = new G4UIcmdWithADouble("/rpc/readout/threshold", this);
+  fThresholdCmd->SetGuidance("Limiar sobre a corrente induzida em cada pad [uA = fC/ns].");
+  fThresholdCmd->SetParameterName("threshold", false);
+  fThresholdCmd->SetRange("threshold > 0.");
+  fThresholdCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fThresholdCmd->SetToBeBroadcasted(false);
+
+  fTimeBinCmd = new G4UIcmdWithADoubleAndUnit("/rpc/readout/timeBin", this);
+  fTimeBinCmd->SetGuidance("Largura do bin de tempo do sinal.");
+  fTimeBinCmd->SetParameterName("binWidth", false);
+  fTimeBinCmd->SetRange("binWidth > 0.");
+  fTimeBinCmd->SetUnitCategory("Time");
+  fTimeBinCmd->SetDefaultUnit("ns");
+  fTimeBinCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fTimeBinCmd->SetToBeBroadcasted(false);
+
+  fNTimeBinsCmd = new G4UIcmdWithAnInteger("/rpc/readout/nTimeBins", this);
+  fNTimeBinsCmd->SetGuidance("Número de bins de tempo, a partir do primeiro elétron do evento.");
+  fNTimeBinsCmd->SetParameterName("nBins", false);
+  fNTimeBinsCmd->SetRange("nBins > 0");
+  fNTimeBinsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fNTimeBinsCmd->SetToBeBroadcasted(false);
+}
+
+ReadoutMessenger::~ReadoutMessenger() {
+  delete fNTimeBinsCmd;
+  delete fTimeBinCmd;
+  delete fThresholdCmd;
+  delete fEnableCmd;
+  delete fReadoutDir;
+}
+
+void ReadoutMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+  if (command == fEnableCmd) {
+    PadReadout::SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+  } else if (command == fThresholdCmd) {
+    PadReadout::SetThreshold(fThresholdCmd->GetNewDoubleValue(newValue));
+  } else if (command == fTimeBinCmd) {
+    PadReadout::SetTimeBinning(fTimeBinCmd->GetNewDoubleValue(newValue) / ns,
+                               PadReadout::GetNumberOfTimeBins());
+  } else if (command == fNTimeBinsCmd) {
+    PadReadout::SetTimeBinning(PadReadout::GetTimeBinWidth(),
+                               fNTimeBinsCmd->GetNewIntValue(newValue));
+  }
+}
+
+G4String ReadoutMessenger::GetCurrentValue(G4UIcommand* command) {
+  if (command == fEnableCmd) {
+    return G4UIcommand::ConvertToString(PadReadout::IsEnabled());
+  } else if (command == fThresholdCmd) {
+    return G4UIcommand::ConvertToString(PadReadout::GetThreshold());
+  } else if (command == fTimeBinCmd) {
+    return fTimeBinCmd->ConvertToString(PadReadout::GetTimeBinWidth() * ns, "ns");
+  } else if (command == fNTimeBinsCmd) {
+    return G4UIcommand::ConvertToString(PadReadout::GetNumberOfTimeBins());
+  }
+  return "";
+}
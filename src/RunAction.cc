@@ -3,38 +3,114 @@
 #include "G4Run.hh"
 #include "G4UserRunAction.hh"
 #include "G4RunManager.hh"
+#include "G4Threading.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4UnitsTable.hh"
 #include "Analysis.hh"
+#include "G4AccumulableManager.hh"
+#include "DetectorParameters.hh"
+#include "PadReadout.hh"
+#include "Log.hh"
+#include "EventOutput.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "AllocationCounter.hh"
+#include "Profiler.hh"
+#include "EventSeeds.hh"
+#include "JobOptions.hh"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+
+RunAction::Summary RunAction::fLastSummary;
+
+namespace {
+    // Tamanho da avalanche por evento em escala log a partir de 1 elétron;
+    // eventos sem avalanche ficam no underflow e os acima do teto no overflow
+    constexpr G4int kAvalancheSizeBins = 140;
+    // Folga sobre o limite do evento: depois dele os primários restantes
+    // ainda contribuem, amostrados com peso
+    constexpr G4double kAvalancheSizeHeadroom = 10.;
+    // Teto sem limites de saturação
+    constexpr G4double kUnlimitedAvalancheSize = 1.e10;
+
+    G4double MaxAvalancheSize() {
+        if (GarfieldPhysics::GetSaturationMode() == GarfieldPhysics::SaturationMode::Off) {
+            return kUnlimitedAvalancheSize;
+        }
+        const G4double limit = std::max(GarfieldPhysics::GetEventSizeLimit(),
+                                        static_cast<G4double>(GarfieldPhysics::GetAvalancheSizeLimit()));
+        return kAvalancheSizeHeadroom * std::max(limit, 1.);
+    }
+}
 
 RunAction::RunAction() : G4UserRunAction() {
 
-    G4RunManager::GetRunManager()->SetPrintProgress(1);
+    // Sem SetPrintProgress: o resumo por evento do EventAction só aparece com
+    // /run/printProgress N na macro (o padrão do Geant4 o deixa desligado)
     G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
     G4cout << "Using" << analysisManager->GetType() << G4endl;
 
     analysisManager->SetVerboseLevel(1);
     analysisManager->SetFirstHistoId(1);
+    // Nome padrão; pode ser trocado por macro com /analysis/setFileName
+    analysisManager->SetFileName("Garfield");
 
     analysisManager->CreateH1("1", "Edep in absorber", 100, 0., 800 * MeV);
     analysisManager->CreateH1("2", "Track length in absorber", 100, 0., 1 * m);
     analysisManager->CreateH1("3", "Edep in gas", 1000, 0., 100 * keV);
 
-    analysisManager->CreateH1("4", "Avalanche size in gas", 10000, 0, 10000);
+    // Binagem refeita em cada BeginOfRunAction pelos limites de saturação
+    analysisManager->CreateH1("4", "Avalanche size in gas", kAvalancheSizeBins, 1., MaxAvalancheSize(),
+                              "none", "none", "log");
     analysisManager->CreateH1("5", "Gain", 1000, 0., 100);
+    // Espectros de entrada no gás, para comparar configurações de física
+    analysisManager->CreateH1("6", "Ekin of e+- entering the gas", 120, 100 * eV, 100 * GeV, "none", "none", "log");
+    analysisManager->CreateH1("7", "Ekin of gammas entering the gas", 120, 100 * eV, 100 * GeV, "none", "none", "log");
+    analysisManager->CreateH1("8", "Ekin of mu+- entering the gas", 100, 10 * MeV, 1 * TeV, "none", "none", "log");
     analysisManager->CreateH3("1", "Track position", 200, -10 * cm, 10 * cm, 29,
                                 -1.45 * cm, 1.45 * cm, 29, -1.45 * cm, 1.45 * cm);
 
-    analysisManager->CreateNtuple("Garfield", "Edep and TrackL");
-    analysisManager->CreateNtupleDColumn("Eabs");
-    analysisManager->CreateNtupleDColumn("Labs");
-    analysisManager->CreateNtupleDColumn("Egas");
-    analysisManager->CreateNtupleDColumn("AvalancheSize");
-    analysisManager->CreateNtupleDColumn("Gain");
-    analysisManager->FinishNtuple();
+    // O ntuple é criado no primeiro BeginOfRunAction, depois dos comandos
+    // /rpc/output/... da macro.
+    fEventOutput = new EventOutput();
+    GarfieldPhysics::GetInstance()->SetEventOutput(fEventOutput);
+
+    G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+#if (G4VERSION_NUMBER < 1100)
+    accumulableManager->RegisterAccumulable(fEfficientEvents);
+    accumulableManager->RegisterAccumulable(fGainEvents);
+    accumulableManager->RegisterAccumulable(fGainSum);
+    accumulableManager->RegisterAccumulable(fGainSum2);
+    accumulableManager->RegisterAccumulable(fAvalancheSum);
+    accumulableManager->RegisterAccumulable(fClusterSizeSum);
+#else
+    accumulableManager->Register(fEfficientEvents);
+    accumulableManager->Register(fGainEvents);
+    accumulableManager->Register(fGainSum);
+    accumulableManager->Register(fGainSum2);
+    accumulableManager->Register(fAvalancheSum);
+    accumulableManager->Register(fClusterSizeSum);
+#endif
+}
+
+void RunAction::AddEvent(G4bool efficient, G4double avalancheSize, G4int nElectrons, G4int nPads) {
+    fAvalancheSum += avalancheSize;
+    if (nElectrons > 0) {
+        const G4double gain = avalancheSize / nElectrons;
+        fGainEvents += 1;
+        fGainSum += gain;
+        fGainSum2 += gain * gain;
+    }
+    if (efficient) {
+        fEfficientEvents += 1;
+        fClusterSizeSum += nPads;
+    }
 }
 
 RunAction::~RunAction(){
+  GarfieldPhysics::GetInstance()->SetEventOutput(nullptr);
+  delete fEventOutput;
 #if (G4VERSION_NUMBER < 1100)
   auto analysisManager = G4AnalysisManager::Instance();
   if (analysisManager) delete analysisManager;
@@ -44,15 +120,71 @@ RunAction::~RunAction(){
 void RunAction::BeginOfRunAction(const G4Run* run) {
     if (isMaster) {
         G4cout << "### RunAction::BeginOfRunAction (Master Thread) -> Inicializando GarfieldPhysics..." << G4endl;
+        // Antes da física: a AvalancheTable é amostrada com a semente do run
+        EventSeeds::BeginRun(run->GetRunID());
+        GarfieldPhysics::InitializeSharedPhysics();
+        GarfieldPhysics::ResetTruncatedEvents();
+    }
+    G4AccumulableManager::Instance()->Reset();
+    // Cada thread que processa eventos tem a sua própria instância. No modo
+    // sequencial quem processa os eventos é o próprio master.
+    if (!isMaster || !G4Threading::IsMultithreadedApplication()) {
         GarfieldPhysics::GetInstance()->InitializePhysics();
     }
 
     G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
-    G4String fileName = "Garfield.root";
-    analysisManager->OpenFile(fileName);
+    const EventOutput::Schema& schema = EventOutput::GetSchema();
+    if (!fEventOutput->IsBooked()) {
+        // Com merging os workers mandam as linhas do ntuple para o arquivo do
+        // master; sem ele cada thread grava <nome>_t<N>.root.
+        analysisManager->SetNtupleMerging(schema.merge);
+        fEventOutput->Book();
+        fRunInfo.Book();
+    }
+    // Os limites mudam por macro entre runs
+    analysisManager->SetH1(4, kAvalancheSizeBins, 1., MaxAvalancheSize(), "none", "none", "log");
+    analysisManager->SetCompressionLevel(schema.compressionLevel);
+    if (isMaster) EventOutput::ResetWriteTime();
+    // Cada thread monta o mesmo nome a partir do /analysis/setFileName da macro
+    fFileName = JobOptions::OutputName(analysisManager->GetFileName());
+    analysisManager->OpenFile(fFileName);
+
+    fTimer.Start();
 }
 
-void RunAction::EndOfRunAction(const G4Run*){
+void RunAction::EndOfRunAction(const G4Run* run){
+    fTimer.Stop();
+    G4AccumulableManager::Instance()->Merge();
+    G4int nofEvents = run->GetNumberOfEvent();
+    if (isMaster) FillSummary(nofEvents, fTimer.GetRealElapsed());
+    if (isMaster && nofEvents > 0) {
+        G4double elapsed = fTimer.GetRealElapsed();
+        G4cout << G4endl << " ----> Run " << run->GetRunID() << ": " << nofEvents
+               << " events in " << elapsed << " s ("
+               << (elapsed > 0. ? nofEvents / elapsed : 0.) << " events/s, log level "
+               << Log::LevelName(Log::GetLevel()) << ")" << G4endl;
+        if (PrimaryGeneratorAction::GetMode() == PrimaryGeneratorAction::kCosmic) {
+            const G4double liveTime = nofEvents * PrimaryGeneratorAction::GetLiveTimePerEvent();
+            RPC_LOG_INFO("[LOG] RunAction::EndOfRunAction -> Múons cósmicos: exposição equivalente de "
+                         << G4BestUnit(liveTime, "Time") << " ("
+                         << PrimaryGeneratorAction::GetLiveTimePerEvent() / ms << " ms por evento)");
+        }
+        if (GarfieldPhysics::GetSaturationMode() != GarfieldPhysics::SaturationMode::Off) {
+            const long truncated = GarfieldPhysics::GetTruncatedEvents();
+            RPC_LOG_INFO("[LOG] RunAction::EndOfRunAction -> Avalanches limitadas: " << truncated << " de "
+                         << nofEvents << " eventos truncados (" << 100. * truncated / nofEvents << " %)");
+        }
+    }
+
+    // Alocações por evento da thread (só com RPC_COUNT_ALLOCATIONS) e
+    // amostras do Profiler; os workers terminam antes do master.
+    if (!isMaster || !G4Threading::IsMultithreadedApplication()) {
+        AllocationCounter::Report();
+        Profiler::MergeThread();
+        if (nofEvents > 0) fRunInfo.Fill(nofEvents);
+    }
+    if (isMaster) Profiler::Report(run->GetRunID());
+
     G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
     if (analysisManager->GetH1(1)) {
         G4cout << G4endl << " ----> print histograms statistic ";
@@ -84,7 +216,72 @@ void RunAction::EndOfRunAction(const G4Run*){
             << " rms = " << analysisManager->GetH1(5)->rms() << G4endl;
     }
 
+    const auto writeStart = std::chrono::steady_clock::now();
     analysisManager->Write();
     analysisManager->CloseFile();
-    
+    EventOutput::AddWriteTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - writeStart).count());
+
+    if (isMaster) PrintOutputSummary(nofEvents);
+}
+
+// Médias do run a partir dos acumuladores já somados pelo Merge()
+void RunAction::FillSummary(G4int nofEvents, G4double seconds) {
+    Summary summary;
+    summary.highVoltage = DetectorParameters::Instance()->GetHighVoltage();
+    summary.events = nofEvents;
+    summary.seconds = seconds;
+    if (nofEvents > 0) {
+        const G4double efficiency = static_cast<G4double>(fEfficientEvents.GetValue()) / nofEvents;
+        summary.efficiency = efficiency;
+        summary.efficiencyError = std::sqrt(efficiency * (1. - efficiency) / nofEvents);
+        summary.avalancheSize = fAvalancheSum.GetValue() / nofEvents;
+    }
+    const G4int nGain = fGainEvents.GetValue();
+    if (nGain > 0) {
+        summary.gain = fGainSum.GetValue() / nGain;
+        const G4double variance = std::max(0., fGainSum2.GetValue() / nGain - summary.gain * summary.gain);
+        summary.gainError = std::sqrt(variance / nGain);
+    }
+    if (fEfficientEvents.GetValue() > 0) {
+        summary.clusterSize = fClusterSizeSum.GetValue() / fEfficientEvents.GetValue();
+    }
+    fLastSummary = summary;
+
+    if (nofEvents > 0) {
+        RPC_LOG_INFO("[LOG] RunAction::EndOfRunAction -> HV " << summary.highVoltage / volt << " V: eficiência "
+                     << 100. * summary.efficiency << " +- " << 100. * summary.efficiencyError << " %, ganho "
+                     << summary.gain << " +- " << summary.gainError << ", cluster size " << summary.clusterSize
+                     << (PadReadout::IsEnabled() ? "" : " (sem pads: eficiência por avalanche)"));
+    }
+}
+
+// Tamanho dos arquivos do run e tempo de escrita (todas as threads),
+// extrapolados para 10^6 eventos.
+void RunAction::PrintOutputSummary(G4int nofEvents) const {
+    if (nofEvents <= 0) return;
+    std::filesystem::path base(fFileName);
+    if (!base.has_extension()) base += ".root";
+    const std::string stem = base.stem().string();
+    const std::string extension = base.extension().string();
+    const std::filesystem::path directory = base.has_parent_path() ? base.parent_path() : ".";
+
+    // Arquivo do master e, sem merging, os das threads (<nome>_t<N>)
+    std::uintmax_t bytes = 0;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() < extension.size() ||
+            name.compare(name.size() - extension.size(), extension.size(), extension) != 0) continue;
+        if (name != stem + extension && name.rfind(stem + "_t", 0) != 0) continue;
+        bytes += entry.file_size(ec);
+    }
+
+    const double perMillion = 1.e6 / nofEvents;
+    const double writeTime = EventOutput::GetWriteTime();
+    RPC_LOG_INFO("[LOG] RunAction::EndOfRunAction -> Output " << base.string() << ": "
+                 << bytes / 1048576. << " MB, write " << writeTime << " s for " << nofEvents
+                 << " events (" << bytes * perMillion / 1073741824. << " GB and "
+                 << writeTime * perMillion / 60. << " min per 10^6 events, "
+                 << (EventOutput::GetSchema().useFloat ? "float" : "double")
+                 << ", compression " << EventOutput::GetSchema().compressionLevel << ")");
 }
\ No newline at end of file
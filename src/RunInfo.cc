@@ -0,0 +1,80 @@
+#include "RunInfo.hh"
+#include "Analysis.hh"
+#include "DetectorParameters.hh"
+#include "EventSeeds.hh"
+#include "JobOptions.hh"
+#include "Physics.hh"
+#include "G4Threading.hh"
+#include "G4Version.hh"
+#include "G4SystemOfUnits.hh"
+#include <string>
+
+// Definido pelo CMake (git rev-parse no momento da configuração)
+#ifndef RPC_GIT_COMMIT
+#define RPC_GIT_COMMIT "unknown"
+#endif
+
+namespace {
+  const char* AvalancheModeName(GarfieldPhysics::AvalancheMode mode) {
+    switch (mode) {
+      case GarfieldPhysics::AvalancheMode::Parameterized: return "parameterized";
+      default: return "full";
+    }
+  }
+
+  const char* FieldModelName(GarfieldPhysics::FieldModel model) {
+    switch (model) {
+      case GarfieldPhysics::FieldModel::Analytic: return "analytic";
+      case GarfieldPhysics::FieldModel::Map: return "map";
+      default: return "uniform";
+    }
+  }
+}
+
+void RunInfo::Book() {
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  fNtupleId = analysisManager->CreateNtuple("RunInfo", "Run metadata");
+  analysisManager->CreateNtupleIColumn("Run");
+  analysisManager->CreateNtupleSColumn("RunSeed");
+  analysisManager->CreateNtupleIColumn("Job");
+  analysisManager->CreateNtupleIColumn("Jobs");
+  analysisManager->CreateNtupleIColumn("EventOffset");
+  analysisManager->CreateNtupleIColumn("Events");
+  analysisManager->CreateNtupleIColumn("Thread");
+  analysisManager->CreateNtupleDColumn("HighVoltage");
+  analysisManager->CreateNtupleDColumn("GasGap");
+  analysisManager->CreateNtupleIColumn("Chambers");
+  analysisManager->CreateNtupleIColumn("GapsPerChamber");
+  analysisManager->CreateNtupleSColumn("GasFile");
+  analysisManager->CreateNtupleSColumn("GasComposition");
+  analysisManager->CreateNtupleSColumn("AvalancheMode");
+  analysisManager->CreateNtupleSColumn("FieldModel");
+  analysisManager->CreateNtupleSColumn("Commit");
+  analysisManager->CreateNtupleSColumn("Geant4");
+  analysisManager->FinishNtuple(fNtupleId);
+}
+
+void RunInfo::Fill(G4int events) {
+  if (fNtupleId < 0) return;
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  const DetectorParameters* detector = DetectorParameters::Instance();
+  G4int column = 0;
+  analysisManager->FillNtupleIColumn(fNtupleId, column++, EventSeeds::GetRun());
+  analysisManager->FillNtupleSColumn(fNtupleId, column++, std::to_string(EventSeeds::GetRunSeed()));
+  analysisManager->FillNtupleIColumn(fNtupleId, column++, JobOptions::GetJob());
+  analysisManager->FillNtupleIColumn(fNtupleId, column++, JobOptions::GetJobs());
+  analysisManager->FillNtupleIColumn(fNtupleId, column++, static_cast<G4int>(EventSeeds::GetEventOffset()));
+  analysisManager->FillNtupleIColumn(fNtupleId, column++, events);
+  analysisManager->FillNtupleIColumn(fNtupleId, column++, G4Threading::G4GetThreadId());
+  analysisManager->FillNtupleDColumn(fNtupleId, column++, detector->GetHighVoltage() / volt);
+  analysisManager->FillNtupleDColumn(fNtupleId, column++, detector->GetGasGap() / mm);
+  analysisManager->FillNtupleIColumn(fNtupleId, column++, detector->GetNumberOfChambers());
+  analysisManager->FillNtupleIColumn(fNtupleId, column++, detector->GetGapsPerChamber());
+  analysisManager->FillNtupleSColumn(fNtupleId, column++, GarfieldPhysics::GetGasFile());
+  analysisManager->FillNtupleSColumn(fNtupleId, column++, GarfieldPhysics::GetGasComposition());
+  analysisManager->FillNtupleSColumn(fNtupleId, column++, AvalancheModeName(GarfieldPhysics::GetAvalancheMode()));
+  analysisManager->FillNtupleSColumn(fNtupleId, column++, FieldModelName(GarfieldPhysics::GetFieldModel()));
+  analysisManager->FillNtupleSColumn(fNtupleId, column++, RPC_GIT_COMMIT);
+  analysisManager->FillNtupleSColumn(fNtupleId, column++, G4Version);
+  analysisManager->AddNtupleRow(fNtupleId);
+}
@@ -0,0 +1,134 @@
+#include "ScanMessenger.hh"
+#include "DetectorParameters.hh"
+#include "RunAction.hh"
+#include "Analysis.hh"
+#include "JobOptions.hh"
+#include "Log.hh"
+#include "G4RunManager.hh"
+#include "G4UImanager.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4SystemOfUnits.hh"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// A tensão é um parâmetro compartilhado e cada ponto é um BeamOn do master,
+// então os comandos só rodam no master.
+ScanMessenger::ScanMessenger() {
+  fScanDir = new G4UIdirectory("/rpc/scan/");
+  fScanDir->SetGuidance("Varredura de tensão: eficiência, ganho e cluster size por ponto.");
+
+  fHighVoltageCmd = new G4UIcommand("/rpc/scan/hv", this);
+  fHighVoltageCmd->SetGuidance("Roda /rpc/scan/events eventos em cada tensão de vMin a vMax (inclusive), com passo step.");
+  fHighVoltageCmd->SetGuidance("O ntuple de cada ponto vai para <arquivo>_<tensão>V; a curva vai para /rpc/scan/file.");
+  fHighVoltageCmd->SetGuidance("Ao final a tensão e o nome do arquivo do ntuple voltam aos de antes.");
+  auto* vMinParam = new G4UIparameter("vMin", 'd', false);
+  fHighVoltageCmd->SetParameter(vMinParam);
+  auto* vMaxParam = new G4UIparameter("vMax", 'd', false);
+  fHighVoltageCmd->SetParameter(vMaxParam);
+  auto* stepParam = new G4UIparameter("step", 'd', false);
+  stepParam->SetParameterRange("step > 0.");
+  fHighVoltageCmd->SetParameter(stepParam);
+  auto* unitParam = new G4UIparameter("unit", 's', true);
+  unitParam->SetDefaultValue("V");
+  unitParam->SetParameterCandidates(G4UIcommand::UnitsList(G4UIcommand::CategoryOf("V")));
+  fHighVoltageCmd->SetParameter(unitParam);
+  fHighVoltageCmd->AvailableForStates(G4State_Idle);
+  fHighVoltageCmd->SetToBeBroadcasted(false);
+
+  fEventsCmd = new G4UIcmdWithAnInteger("/rpc/scan/events", this);
+  fEventsCmd->SetGuidance("Eventos por ponto da varredura.");
+  fEventsCmd->SetParameterName("events", false);
+  fEventsCmd->SetRange("events > 0");
+  fEventsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEventsCmd->SetToBeBroadcasted(false);
+
+  fFileCmd = new G4UIcmdWithAString("/rpc/scan/file", this);
+  fFileCmd->SetGuidance("Arquivo CSV da curva; é reescrito a cada /rpc/scan/hv.");
+  fFileCmd->SetParameterName("fileName", false);
+  fFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fFileCmd->SetToBeBroadcasted(false);
+}
+
+ScanMessenger::~ScanMessenger() {
+  delete fFileCmd;
+  delete fEventsCmd;
+  delete fHighVoltageCmd;
+  delete fScanDir;
+}
+
+void ScanMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+  if (command == fHighVoltageCmd) {
+    std::istringstream is(newValue);
+    G4double vMin = 0., vMax = 0., step = 0.;
+    G4String unit;
+    is >> vMin >> vMax >> step >> unit;
+    const G4double factor = G4UIcommand::ValueOf(unit);
+    Scan(vMin * factor, vMax * factor, step * factor);
+  } else if (command == fEventsCmd) {
+    fEvents = fEventsCmd->GetNewIntValue(newValue);
+  } else if (command == fFileCmd) {
+    fFileName = newValue;
+  }
+}
+
+G4String ScanMessenger::GetCurrentValue(G4UIcommand* command) {
+  if (command == fEventsCmd) return fEventsCmd->ConvertToString(fEvents);
+  if (command == fFileCmd) return fFileName;
+  return "";
+}
+
+void ScanMessenger::Scan(G4double vMin, G4double vMax, G4double step) {
+  std::ofstream csv(fFileName);
+  if (!csv) {
+    RPC_LOG_ERROR("[LOG] ScanMessenger::Scan -> não foi possível abrir " << fFileName);
+    return;
+  }
+  csv << "hv_V,events,efficiency,efficiency_err,gain,gain_err,avalanche_size,cluster_size,seconds\n";
+
+  DetectorParameters* detector = DetectorParameters::Instance();
+  G4UImanager* uiManager = G4UImanager::GetUIpointer();
+  const G4double savedHighVoltage = detector->GetHighVoltage();
+  // Sem o prefixo/sufixo do job, que o RunAction acrescenta a cada ponto
+  const G4String savedFileName = JobOptions::StripOutputName(G4AnalysisManager::Instance()->GetFileName());
+  // O sufixo do ponto vai antes da extensão, se houver
+  std::string baseName = savedFileName, extension;
+  const auto dot = baseName.find_last_of('.');
+  if (dot != std::string::npos && baseName.find('/', dot) == std::string::npos) {
+    extension = baseName.substr(dot);
+    baseName.erase(dot);
+  }
+
+  // Número de pontos calculado antes, para o passo não acumular erro de
+  // arredondamento (5000 a 7000 de 100 V são sempre 21 pontos)
+  const G4int nPoints = static_cast<G4int>(std::floor((vMax - vMin) / step + 1e-6)) + 1;
+  RPC_LOG_INFO("[LOG] ScanMessenger::Scan -> " << nPoints << " pontos de " << vMin / volt << " V a "
+               << vMax / volt << " V, " << fEvents << " eventos cada; curva em " << fFileName);
+
+  for (G4int i = 0; i < nPoints; ++i) {
+    const G4double hv = vMin + i * step;
+    detector->SetHighVoltage(hv);
+    std::ostringstream fileName;
+    fileName << baseName << "_" << std::lround(hv / volt) << "V" << extension;
+    uiManager->ApplyCommand("/analysis/setFileName " + fileName.str());
+
+    G4RunManager::GetRunManager()->BeamOn(fEvents);
+
+    const RunAction::Summary& summary = RunAction::GetLastSummary();
+    csv << hv / volt << ',' << summary.events << ','
+        << summary.efficiency << ',' << summary.efficiencyError << ','
+        << summary.gain << ',' << summary.gainError << ','
+        << summary.avalancheSize << ',' << summary.clusterSize << ','
+        << summary.seconds << std::endl;
+  }
+
+  detector->SetHighVoltage(savedHighVoltage);
+  uiManager->ApplyCommand("/analysis/setFileName " + savedFileName);
+  RPC_LOG_INFO("[LOG] ScanMessenger::Scan -> varredura concluída; tensão de volta a "
+               << savedHighVoltage / volt << " V");
+}
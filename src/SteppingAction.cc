@@ -4,28 +4,59 @@
 #include "G4Step.hh"
 #include "G4LogicalVolume.hh"
 #include "G4RunManager.hh"
+#include "Profiler.hh"
+#include "Analysis.hh"
+#include <cstdlib>
 
 SteppingAction::SteppingAction(EventAction* eventAction)
 : G4UserSteppingAction(),
   fEventAction(eventAction)
-{}
+{
+  // O DetectorConstruction é o mesmo objeto no master e nos workers
+  fDetector = static_cast<const DetectorConstruction*>(
+      G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+}
 
 SteppingAction::~SteppingAction()
 {}
 
 void SteppingAction::UserSteppingAction(const G4Step* step)
 {
-  G4LogicalVolume* volume 
+  Profiler::Count(Profiler::kSteps);
+
+  const G4LogicalVolume* volume 
     = step->GetPreStepPoint()->GetTouchableHandle()->GetVolume()->GetLogicalVolume();
+  const G4int layer = fDetector->GetLayer(volume);
   
-  if (volume->GetName() != "GasVolumeLV") {
+  if (layer != DetectorLayer::kGas) {
     G4double edep = step->GetTotalEnergyDeposit();
     G4double stepl = 0.;
     if (step->GetTrack()->GetDefinition()->GetPDGCharge() != 0.) {
       stepl = step->GetStepLength();
     }
     if (edep > 0. || stepl > 0.) {
-        fEventAction->AddAbs(edep, stepl);
+        fEventAction->AddAbs(layer, edep, stepl);
     }
   }
+
+  // Espectro de entrada no gás (histogramas 6-8)
+  const G4StepPoint* postStep = step->GetPostStepPoint();
+  if (layer != DetectorLayer::kGas && postStep->GetStepStatus() == fGeomBoundary) {
+    const G4VPhysicalVolume* next = postStep->GetTouchableHandle()->GetVolume();
+    if (next && fDetector->GetLayer(next->GetLogicalVolume()) == DetectorLayer::kGas) {
+      FillGasEntry(step->GetTrack()->GetDefinition()->GetPDGEncoding(), postStep->GetKineticEnergy());
+    }
+  }
+}
+
+void SteppingAction::FillGasEntry(G4int pdg, G4double ekin) const
+{
+  G4int id = 0;
+  switch (std::abs(pdg)) {
+    case 11: id = 6; break;
+    case 22: id = 7; break;
+    case 13: id = 8; break;
+    default: return;
+  }
+  G4AnalysisManager::Instance()->FillH1(id, ekin);
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "WeightingPotentialTable.hh"
+#include <algorithm>
+#include <cmath>
+#include "Garfield/ComponentAnalyticField.hh"
+
+namespace {
+  // Passo da tabela relativo à distância entre terra e pads; pontos em y
+  // dentro do gap
+  constexpr int kStepsPerSpacing = 10;
+  constexpr int kNY = 21;
+  // Além da borda do pad o potencial cai em poucas distâncias terra-pads
+  constexpr double kMarginInSpacings = 5.;
+  const std::string kPadLabel = "pad";
+}
+
+void WeightingPotentialTable::Build(double gap, double groundDistance, double padDistance,
+                                    double halfX, double halfZ) {
+  const double yGround = -0.5 * gap - groundDistance;
+  const double yPads = 0.5 * gap + padDistance;
+  const double spacing = yPads - yGround;
+  fGap = gap;
+  fStep = std::min(spacing, std::min(halfX, halfZ)) / kStepsPerSpacing;
+  fRangeX = halfX + kMarginInSpacings * spacing;
+  fRangeZ = halfZ + kMarginInSpacings * spacing;
+  fNX = static_cast<int>(std::ceil(fRangeX / fStep)) + 1;
+  fNZ = static_cast<int>(std::ceil(fRangeZ / fStep)) + 1;
+  fNY = kNY;
+
+  Garfield::ComponentAnalyticField cmp;
+  cmp.AddPlaneY(yGround, 0., "ground");
+  cmp.AddPlaneY(yPads, 0., "pads");
+  cmp.AddPixelOnPlaneY(yPads, -halfX, halfX, -halfZ, halfZ, kPadLabel);
+  cmp.AddReadout(kPadLabel);
+
+  fAlongX.assign(static_cast<size_t>(fNX) * fNY, 0.);
+  fAlongZ.assign(static_cast<size_t>(fNZ) * fNY, 0.);
+  fCenter.assign(fNY, 0.);
+  for (int iy = 0; iy < fNY; ++iy) {
+    const double y = -0.5 * gap + gap * iy / (fNY - 1);
+    for (int iu = 0; iu < fNX; ++iu) {
+      fAlongX[iy * fNX + iu] = cmp.WeightingPotential(iu * fStep, y, 0., kPadLabel);
+    }
+    for (int iu = 0; iu < fNZ; ++iu) {
+      fAlongZ[iy * fNZ + iu] = cmp.WeightingPotential(0., y, iu * fStep, kPadLabel);
+    }
+    fCenter[iy] = fAlongX[iy * fNX];
+  }
+}
+
+double WeightingPotentialTable::Interpolate(const std::vector<double>& table, int nU,
+                                            double u, double y) const {
+  const double fu = std::min(u / fStep, nU - 1.);
+  const double fy = std::min(std::max((y + 0.5 * fGap) / fGap * (fNY - 1), 0.), fNY - 1.);
+  const int iu = std::min(static_cast<int>(fu), nU - 2);
+  const int iy = std::min(static_cast<int>(fy), fNY - 2);
+  const double wu = fu - iu;
+  const double wy = fy - iy;
+  const double* row0 = &table[iy * nU];
+  const double* row1 = row0 + nU;
+  return (1. - wy) * ((1. - wu) * row0[iu] + wu * row0[iu + 1]) +
+         wy * ((1. - wu) * row1[iu] + wu * row1[iu + 1]);
+}
+
+double WeightingPotentialTable::Evaluate(double dx, double y, double dz) const {
+  const double ax = std::abs(dx);
+  const double az = std::abs(dz);
+  if (ax >= fRangeX || az >= fRangeZ) return 0.;
+
+  const double fy = std::min(std::max((y + 0.5 * fGap) / fGap * (fNY - 1), 0.), fNY - 1.);
+  const int iy = std::min(static_cast<int>(fy), fNY - 2);
+  const double center = fCenter[iy] + (fy - iy) * (fCenter[iy + 1] - fCenter[iy]);
+  if (center <= 0.) return 0.;
+  return Interpolate(fAlongX, fNX, ax, y) * Interpolate(fAlongZ, fNZ, az, y) / center;
+}
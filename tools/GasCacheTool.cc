@@ -0,0 +1,54 @@
+// rpc_gascache: converte um arquivo .gas do Magboltz no cache binário lido
+// pelo RPC (ver GasTableCache). O cache gravado é conferido contra o .gas e
+// apagado se não o reproduz; --check só faz a conferência de um cache já
+// existente.
+//
+//   rpc_gascache rpc_gas_5_5_90.gas [rpc_gas_5_5_90.gas.bin]
+//   rpc_gascache --check rpc_gas_5_5_90.gas [rpc_gas_5_5_90.gas.bin]
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "Garfield/MediumMagboltz.hh"
+#include "GasTableCache.hh"
+
+int main(int argc, char** argv) {
+  const bool checkOnly = argc > 1 && std::strcmp(argv[1], "--check") == 0;
+  const int first = checkOnly ? 2 : 1;
+  if (argc < first + 1 || argc > first + 2) {
+    std::cerr << "Usage: " << argv[0] << " [--check] <file.gas> [cache file]" << std::endl;
+    return 1;
+  }
+  const std::string gasFile = argv[first];
+  const std::string cacheFile =
+      argc > first + 1 ? argv[first + 1] : GasTableCache::DefaultCacheName(gasFile);
+
+  Garfield::MediumMagboltz gas;
+  if (!gas.LoadGasFile(gasFile)) {
+    std::cerr << "Could not read " << gasFile << std::endl;
+    return 1;
+  }
+  if (!checkOnly && !GasTableCache::Write(gas, cacheFile, gasFile)) {
+    std::cerr << "Could not write " << cacheFile << std::endl;
+    return 1;
+  }
+
+  std::string report;
+  if (!GasTableCache::Check(gas, cacheFile, gasFile, &report)) {
+    std::cerr << cacheFile << " does not reproduce " << gasFile << ":\n" << report << std::endl;
+    if (!checkOnly) {
+      std::remove(cacheFile.c_str());
+      std::cerr << "Removed " << cacheFile << std::endl;
+    }
+    return 1;
+  }
+  if (checkOnly) {
+    std::cout << cacheFile << ": " << report << std::endl;
+    return 0;
+  }
+
+  std::cout << "Wrote " << cacheFile << " (" << GasTableCache::CompositionKey(gas)
+            << ", T = " << gas.GetTemperature() << " K, p = "
+            << gas.GetPressure() << " Torr; " << report << ")" << std::endl;
+  return 0;
+}
@@ -0,0 +1,96 @@
+// rpc_merge: junta as saídas de vários jobs (ou das threads, sem merging) do
+// RPC em um só arquivo.
+//
+//   rpc_merge saida.root job0.root job1.root ...
+//
+// Histogramas com o mesmo nome são somados; ntuples com o mesmo nome
+// (Garfield, RunInfo) são concatenados com a cópia rápida dos baskets, sem
+// descomprimir. Os arquivos de entrada são abertos um de cada vez, então a
+// memória é a de um conjunto de histogramas mais os baskets em cópia,
+// qualquer que seja o número de jobs. Só o diretório raiz de cada arquivo é
+// lido, que é onde o G4AnalysisManager grava.
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "TChain.h"
+#include "TClass.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TKey.h"
+#include "TTree.h"
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <output.root> <input.root> [input.root ...]" << std::endl;
+    return 1;
+  }
+  const std::string outputName = argv[1];
+  const std::vector<std::string> inputs(argv + 2, argv + argc);
+
+  // Os histogramas somados ficam só na memória do programa, fora dos TFile
+  TH1::AddDirectory(false);
+  std::map<std::string, std::unique_ptr<TH1>> histograms;
+  // Ntuple -> arquivos que o contêm, na ordem da linha de comando
+  std::vector<std::string> treeNames;
+  std::map<std::string, std::vector<std::string>> treeFiles;
+
+  for (const auto& input : inputs) {
+    std::unique_ptr<TFile> file(TFile::Open(input.c_str(), "READ"));
+    if (!file || file->IsZombie()) {
+      std::cerr << "Could not open " << input << std::endl;
+      return 1;
+    }
+    // Um objeto pode ter vários ciclos; Get() devolve o mais recente
+    std::set<std::string> names;
+    TIter next(file->GetListOfKeys());
+    while (auto* key = static_cast<TKey*>(next())) {
+      const std::string name = key->GetName();
+      if (!names.insert(name).second) continue;
+      TClass* objectClass = TClass::GetClass(key->GetClassName());
+      if (!objectClass) continue;
+
+      if (objectClass->InheritsFrom(TTree::Class())) {
+        if (treeFiles.find(name) == treeFiles.end()) treeNames.push_back(name);
+        treeFiles[name].push_back(input);
+      } else if (objectClass->InheritsFrom(TH1::Class())) {
+        std::unique_ptr<TH1> histogram(static_cast<TH1*>(file->Get(name.c_str())));
+        if (!histogram) continue;
+        auto it = histograms.find(name);
+        if (it == histograms.end()) {
+          histograms.emplace(name, std::move(histogram));
+        } else if (!it->second->Add(histogram.get())) {
+          std::cerr << "Histogram " << name << " in " << input << " has a different binning" << std::endl;
+          return 1;
+        }
+      }
+    }
+  }
+
+  TFile output(outputName.c_str(), "RECREATE");
+  if (output.IsZombie()) {
+    std::cerr << "Could not create " << outputName << std::endl;
+    return 1;
+  }
+
+  // O TChain lê um arquivo de cada vez; "keep" deixa o arquivo de saída aberto
+  for (const auto& name : treeNames) {
+    TChain chain(name.c_str());
+    for (const auto& input : treeFiles[name]) chain.Add(input.c_str());
+    const Long64_t entries = chain.Merge(&output, 0, "fast keep");
+    std::cout << name << ": " << entries << " entries from " << treeFiles[name].size() << " file(s)"
+              << std::endl;
+  }
+
+  output.cd();
+  for (auto& item : histograms) {
+    item.second->Write(item.first.c_str());
+  }
+  output.Close();
+
+  std::cout << "Wrote " << outputName << " (" << inputs.size() << " input(s), " << histograms.size()
+            << " histogram(s), " << treeNames.size() << " ntuple(s))" << std::endl;
+  return 0;
+}